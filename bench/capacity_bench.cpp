@@ -0,0 +1,115 @@
+// =============================================================================
+// capacity_bench.cpp - 大容量下的定价代价基准
+// =============================================================================
+// 同一组相对尺寸 (容量的固定比例) 在容量C = 1e3 ~ 1e9上:
+//   1. 背包分支定界的耗时与搜索节点数 (应与容量无关)
+//   2. C <= 1e6时可达位置的生成耗时与位置数, 及与可达位置DP的最优值对照
+// 构建: cmake -DBUILD_BENCHMARKS=ON, 运行: capacity-bench
+// =============================================================================
+
+#include "2DBP.h"
+
+#include <random>
+
+using namespace std;
+
+// 计时: 重复执行fn直到累计时间超过下限, 返回单次平均毫秒数
+template <typename Fn>
+static double TimeMs(Fn fn) {
+    using Clock = chrono::high_resolution_clock;
+    int reps = 0;
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        reps++;
+        elapsed = chrono::duration<double, milli>(Clock::now() - start).count();
+    } while (elapsed < 200.0);
+    return elapsed / reps;
+}
+
+int main() {
+    const int num_items = 30;
+    mt19937 rng(2024);
+
+    // 相对尺寸取 [1/20, 1/3], 价值近似按尺寸成比例并加扰动
+    uniform_real_distribution<double> frac_dist(1.0 / 20, 1.0 / 3);
+    uniform_real_distribution<double> noise(0.8, 1.2);
+    vector<double> fracs(num_items);
+    vector<double> values(num_items);
+    for (int i = 0; i < num_items; i++) {
+        fracs[i] = frac_dist(rng);
+        values[i] = noise(rng) * fracs[i];
+    }
+
+    ProblemParams params;
+    KnapsackDP kp;
+    KnapsackBB kb;
+    vector<vector<int>> patterns;
+
+    LOG_FMT("[Bench] 物品数 %d, 相对尺寸 [1/20, 1/3]\n", num_items);
+    LOG("  容量C        B&B(ms)  B&B节点数  可达位置(ms)  可达位置数   DP最优值差");
+
+    vector<double> bb_ms_list;
+    for (long long capacity : {1000LL, 10000LL, 100000LL, 1000000LL,
+             10000000LL, 100000000LL, 1000000000LL}) {
+
+        // 尺寸按容量缩放, 奇偶交替微调使gcd为1 (不因公约数缩放而变得廉价)
+        vector<int> sizes(num_items);
+        for (int i = 0; i < num_items; i++) {
+            sizes[i] = static_cast<int>(fracs[i] * capacity) | (i % 2);
+        }
+        int cap = static_cast<int>(capacity);
+
+        PrepareKnapsackBB(kb, num_items);
+        kb.sizes_ = sizes;
+        kb.values_ = values;
+
+        // 阈值取最优值附近, 使搜索必须证明最优
+        double opt_val = 0.0;
+        SolveKnapsackBB(params, kb, cap, 0.0, opt_val, patterns);
+        double threshold = opt_val * 0.999;
+        bool finished = true;
+        double bb_ms = TimeMs([&]() {
+            double val = 0.0;
+            finished = SolveKnapsackBB(params, kb, cap, threshold, val, patterns) && finished;
+        });
+        long long bb_nodes = kb.num_nodes_;
+        bb_ms_list.push_back(bb_ms);
+
+        // 可达位置与DP只在中小容量上对照 (此类实例的可达位置随容量变稠密, 正是B&B的适用场景)
+        double raster_ms = NAN;
+        double dp_gap = NAN;
+        RasterPoints raster;
+        if (capacity <= 1000000) {
+            raster_ms = TimeMs([&]() {
+                ComputeRasterPoints(sizes, cap, raster);
+            });
+
+            PrepareKnapsackDP(kp, num_items);
+            kp.sizes_ = sizes;
+            kp.values_ = values;
+            params.dp_kernel_ = kDPExact;
+            dp_gap = fabs(SolveKnapsackDP(params, kp, raster, INFINITY) - opt_val);
+        }
+
+        LOG_FMT("  %-11lld  %8.3f  %9lld  %12.3f  %10d   %.2e\n",
+            capacity, bb_ms, bb_nodes, raster_ms, (int)raster.points_.size(), dp_gap);
+        if (!finished) {
+            LOG("  [警告] 分支定界搜索节点数超限");
+        }
+        if (dp_gap > 1e-9) {
+            LOG("  [警告] 分支定界与DP最优值不一致");
+        }
+    }
+
+    // 容量无关: 最大容量下的耗时与最小容量同一量级
+    double ratio = bb_ms_list.back() / bb_ms_list.front();
+    LOG_FMT("[Bench] B&B耗时比 (C=1e9 / C=1e3): %.2f\n", ratio);
+    if (ratio > 10.0) {
+        LOG("  [警告] 分支定界耗时随容量增长");
+        return 1;
+    }
+
+    return 0;
+}
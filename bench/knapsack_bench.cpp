@@ -0,0 +1,142 @@
+// =============================================================================
+// knapsack_bench.cpp - DP背包内核微基准
+// =============================================================================
+// 对比以下实现在容量L = 1e3 ~ 1e6上的耗时:
+//   1. 原SolveRootSP2DP内层循环 (逐位置双精度, 带分支)
+//   2. SolveKnapsackDP双精度内核 (可达位置)
+//   3. SolveKnapsackDP定点内核 (运行时选择的SIMD级别, 含证书判定)
+//   4. 定点松弛内核在各SIMD级别下的耗时
+// 构建: cmake -DBUILD_BENCHMARKS=ON, 运行: knapsack-bench
+// =============================================================================
+
+#include "2DBP.h"
+
+#include <random>
+
+using namespace std;
+
+// 原SolveRootSP2DP的内层循环 (逐位置, 单前驱指针)
+static double LegacyKnapsackDP(const vector<int>& sizes, const vector<double>& values,
+    int capacity, vector<double>& dp, vector<int>& last_item) {
+
+    dp.assign(capacity + 1, 0.0);
+    last_item.assign(capacity + 1, -1);
+    for (int i = 0; i < (int)sizes.size(); i++) {
+        int len = sizes[i];
+        double val = values[i];
+        if (val <= 0) continue;
+
+        for (int l = len; l <= capacity; l++) {
+            if (dp[l - len] + val > dp[l]) {
+                dp[l] = dp[l - len] + val;
+                last_item[l] = i;
+            }
+        }
+    }
+    return dp[capacity];
+}
+
+// 计时: 重复执行fn直到累计时间超过下限, 返回单次平均毫秒数
+template <typename Fn>
+static double TimeMs(Fn fn) {
+    using Clock = chrono::high_resolution_clock;
+    int reps = 0;
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        reps++;
+        elapsed = chrono::duration<double, milli>(Clock::now() - start).count();
+    } while (elapsed < 200.0);
+    return elapsed / reps;
+}
+
+int main() {
+    const int num_items = 40;
+    mt19937 rng(2024);
+
+    ProblemParams params;
+    KnapsackDP kp;
+    vector<double> legacy_dp;
+    vector<int> legacy_last;
+
+    LOG_FMT("[Bench] 物品数 %d, 运行时SIMD级别: %s\n",
+        num_items, SimdLevelName(DetectSimdLevel()));
+    LOG("  容量L      原循环(ms)  双精度(ms)  定点(ms)   加速比   上界-最优值");
+
+    for (int capacity : {1000, 10000, 100000, 1000000}) {
+        // 子件长度取 [L/50, L/4], 对偶价格近似按长度成比例并加扰动
+        uniform_int_distribution<int> len_dist(max(1, capacity / 50), max(2, capacity / 4));
+        uniform_real_distribution<double> noise(0.8, 1.2);
+        vector<int> sizes(num_items);
+        vector<double> values(num_items);
+        for (int i = 0; i < num_items; i++) {
+            sizes[i] = len_dist(rng);
+            values[i] = noise(rng) * sizes[i] / capacity;
+        }
+
+        RasterPoints raster;
+        ComputeRasterPoints(sizes, capacity, raster);
+
+        PrepareKnapsackDP(kp, num_items);
+        kp.sizes_ = sizes;
+        kp.values_ = values;
+
+        double legacy_val = 0.0;
+        double legacy_ms = TimeMs([&]() {
+            legacy_val = LegacyKnapsackDP(sizes, values, capacity, legacy_dp, legacy_last);
+        });
+
+        params.dp_kernel_ = kDPExact;
+        double exact_val = 0.0;
+        double exact_ms = TimeMs([&]() {
+            exact_val = SolveKnapsackDP(params, kp, raster, INFINITY);
+        });
+
+        // 阈值取精确最优值附近, 使定点内核必须给出确定结论
+        params.dp_kernel_ = kDPFixedPoint;
+        double fixed_val = 0.0;
+        double fixed_ms = TimeMs([&]() {
+            fixed_val = SolveKnapsackDP(params, kp, raster, exact_val * 0.999);
+        });
+
+        LOG_FMT("  %-9d  %10.3f  %10.3f  %8.3f  %7.2fx  %.2e\n",
+            capacity, legacy_ms, exact_ms, fixed_ms, legacy_ms / fixed_ms,
+            fabs(fixed_val - legacy_val));
+        if (fabs(exact_val - legacy_val) > 1e-9) {
+            LOG("  [警告] 双精度内核与原循环最优值不一致");
+        }
+    }
+
+    // 定点松弛内核本身 (稠密网格, 不含映射与证书)
+    LOG("[Bench] 定点松弛内核 (每物品松弛一遍稠密网格)");
+    LOG("  容量L      标量(ms)    SSE4.1(ms)  AVX2(ms)");
+    for (int capacity : {1000, 10000, 100000, 1000000}) {
+        uniform_int_distribution<int> len_dist(max(8, capacity / 50), max(9, capacity / 4));
+        vector<int> sizes(num_items);
+        for (int& size : sizes) {
+            size = len_dist(rng);
+        }
+
+        vector<int32_t> dp(capacity + 1);
+        vector<int32_t> last(capacity + 1);
+        double ms[3] = {0.0, 0.0, 0.0};
+        for (int level = kSimdScalar; level <= kSimdAVX2; level++) {
+            if (level > DetectSimdLevel()) {
+                ms[level] = NAN;
+                continue;
+            }
+            ms[level] = TimeMs([&]() {
+                fill(dp.begin(), dp.end(), 0);
+                fill(last.begin(), last.end(), -1);
+                for (int i = 0; i < num_items; i++) {
+                    RelaxFixedItem(level, dp.data(), last.data(), capacity + 1,
+                        sizes[i], 1000 + i, i);
+                }
+            });
+        }
+        LOG_FMT("  %-9d  %10.3f  %10.3f  %8.3f\n", capacity, ms[0], ms[1], ms[2]);
+    }
+
+    return 0;
+}
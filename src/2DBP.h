@@ -9,22 +9,31 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <climits>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#ifndef CS_NO_CPLEX
 #include <ilcplex/ilocplex.h>
+#endif
 
 #include "logger.h"
 
@@ -36,11 +45,61 @@ constexpr double kZeroTolerance = 1.0e-10;  // 零值容差
 constexpr int kMaxCgIter = 100;             // 列生成最大迭代次数
 const string kFilePath = "data/test.txt";   // 默认数据文件路径
 
+// 稀疏列: 只存非零元 (行号, 系数)
+using SparseColumn = vector<pair<int, double>>;
+
 // 子问题求解方法枚举
 enum SPMethod {
     kCplexIP = 0,   // CPLEX整数规划
     kArcFlow = 1,   // Arc Flow模型
-    kDP = 2         // 动态规划
+    kDP = 2,        // 动态规划
+    kBranchBound = 3    // 背包分支定界 (代价与容量无关)
+};
+
+// 定价轮次模式枚举
+enum PricingMode {
+    kSequentialPricing = 0,     // 逐列: SP1收敛后才求SP2, 每个新列后立即重解主问题
+    kBatchPricing = 1,          // 批量: SP1与全部SP2共用一组对偶价格, 每轮只重解一次主问题
+    kJointPricing = 2           // 联合: 在批量定价基础上先求SP2, SP1按条带的SP2最优值计价, 整板方案同轮加入
+};
+
+// 对偶稳定化模式枚举
+enum StabMode {
+    kNoStabilization = 0,   // 不稳定化, 直接使用主问题对偶价格
+    kSmoothing = 1,         // Wentges平滑
+    kBoxStep = 2            // Box-step: 对偶价格限制在稳定中心附近的箱内
+};
+
+// 主问题LP求解后端枚举
+enum MPMethod {
+    kMPCplex = 0,   // CPLEX (Concert)
+    kMPSimplex = 1  // 内置有界修正单纯形法
+};
+
+// 主问题对偶价格类型枚举
+enum DualMode {
+    kVertexDuals = 0,   // 单纯形法最优基对应的顶点对偶价格
+    kCentralDuals = 1   // 内点法 (不做crossover) 得到的最优面内部对偶价格
+};
+
+// 内置单纯形法变量状态
+enum SimplexVarStatus {
+    kVarBasic = 0,      // 基变量
+    kVarAtLower = 1,    // 非基, 取下界0
+    kVarAtUpper = 2     // 非基, 取上界
+};
+
+// DP背包内核
+enum DPKernel {
+    kDPExact = 0,       // 双精度DP (在可达位置上展开)
+    kDPFixedPoint = 1   // 定点整数DP (SIMD向量化, 舍入误差有证书, 无法判定时回退双精度)
+};
+
+// SIMD指令集级别 (运行时检测)
+enum SimdLevel {
+    kSimdScalar = 0,    // 标量
+    kSimdSSE41 = 1,     // SSE4.1 (4路int32)
+    kSimdAVX2 = 2       // AVX2 (8路int32)
 };
 
 // 子件类型: 存储同一规格子件的类型信息
@@ -59,43 +118,33 @@ struct StripType {
     int length_ = -1;       // 长度 (X轴, 等于母板长度)
 };
 
-// SP2 Arc Flow网络数据: 用于条带上的子件排列 (长度方向背包)
-// 节点表示条带上的位置 (0到stock_length), Arc表示放置一个子件
-struct SP2ArcFlowData {
-    int strip_type_id_ = -1;                // 对应的条带类型
-    vector<int> begin_nodes_;               // 起点节点 (位置0)
-    vector<int> end_nodes_;                 // 终点节点 (位置stock_length)
-    vector<int> mid_nodes_;                 // 中间节点
-    vector<array<int, 2>> arc_list_;        // Arc列表 [起点, 终点]
-    map<array<int, 2>, int> arc_to_index_;  // Arc到索引的映射
-
-    // Arc分类索引
-    vector<int> begin_arc_indices_;         // 从起点出发的Arc
-    vector<int> end_arc_indices_;           // 到达终点的Arc
-    vector<vector<int>> mid_in_arcs_;       // 中间节点入弧
-    vector<vector<int>> mid_out_arcs_;      // 中间节点出弧
+// 可达位置集合 (raster points / 正规方案位置)
+// 只有若干尺寸之和构成的位置才可能成为切割位置, DP与Arc Flow只需在这些位置上展开
+// 位置按尺寸的最大公约数缩放后生成 (稀疏时逐尺寸归并, 稠密时位并行子集和)
+// 只保存可达位置本身 (按位置二分查找), 内存与可达位置数成正比而与容量无关
+struct RasterPoints {
+    int capacity_ = 0;                      // 容量 (原始单位)
+    int gcd_ = 1;                           // 尺寸的最大公约数
+    vector<int> points_;                    // 可达位置 (原始单位, 升序, 含0)
 };
 
-// SP1 Arc Flow网络数据: 用于母板上的条带排列 (宽度方向背包)
-// 节点表示母板宽度方向的位置 (0到stock_width), Arc表示放置一种条带
-struct SP1ArcFlowData {
-    vector<int> begin_nodes_;               // 起点节点 (位置0)
-    vector<int> end_nodes_;                 // 终点节点 (位置stock_width)
-    vector<int> mid_nodes_;                 // 中间节点
-    vector<array<int, 2>> arc_list_;        // Arc列表 [起点, 终点]
-    map<array<int, 2>, int> arc_to_index_;  // Arc到索引的映射
-
-    // Arc分类索引
-    vector<int> begin_arc_indices_;         // 从起点出发的Arc
-    vector<int> end_arc_indices_;           // 到达终点的Arc
-    vector<vector<int>> mid_in_arcs_;       // 中间节点入弧
-    vector<vector<int>> mid_out_arcs_;      // 中间节点出弧
-};
-
-// 新列: 列生成过程中子问题产生的新切割方案
-struct NewColumn {
-    vector<int> pattern_;               // 切割方案系数
-    set<array<int, 2>> arc_set_;        // 对应的Arc集合
+// Arc Flow网络 (SP1母板宽度方向与SP2条带长度方向共用, 压缩稀疏行存储)
+// 节点为可达位置 (升序, 节点0为位置0, 最后一个节点为终点capacity_)
+// Arc表示放置一个物品, 损耗弧从各位置直连终点, 使方案不必恰好填满
+// Arc按起点节点升序存储, 节点v的出弧为 [out_offsets_[v], out_offsets_[v + 1]),
+// 入弧为 in_arcs_[in_offsets_[v]] ~ in_arcs_[in_offsets_[v + 1] - 1]
+// 尺寸相同的多种物品共用一条Arc, Arc a可放置的物品为
+// arc_items_[arc_item_offsets_[a]] ~ arc_items_[arc_item_offsets_[a + 1] - 1] (损耗弧为-1)
+struct ArcFlowGraph {
+    int capacity_ = 0;                      // 容量 (终点位置)
+    vector<int> node_pos_;                  // 节点位置
+    vector<int> arc_tail_;                  // Arc起点节点
+    vector<int> arc_head_;                  // Arc终点节点
+    vector<int> out_offsets_;               // 出弧区间 (节点数 + 1)
+    vector<int> in_offsets_;                // 入弧区间 (节点数 + 1)
+    vector<int> in_arcs_;                   // 按终点节点分组的Arc下标
+    vector<int> arc_item_offsets_;          // 物品列表区间 (Arc数 + 1)
+    vector<int> arc_items_;                 // 物品类型下标, -1=损耗弧
 };
 
 // Y列 (第一阶段): 母板切割为条带的方案
@@ -103,6 +152,8 @@ struct YColumn {
     vector<int> pattern_;               // pattern_[j] = 条带类型j的数量
     set<array<int, 2>> arc_set_;        // 对应的Arc集合 (宽度方向)
     double value_ = 0.0;                // LP解值
+    int age_ = 0;                       // 连续处于非基状态的主问题求解次数
+    int protect_flag_ = 0;              // 保护标志: 1=不可清除 (初始列/分支列)
 };
 
 // X列 (第二阶段): 条带切割为子件的方案
@@ -111,6 +162,8 @@ struct XColumn {
     vector<int> pattern_;               // pattern_[i] = 子件类型i的数量
     set<array<int, 2>> arc_set_;        // 对应的Arc集合 (长度方向)
     double value_ = 0.0;                // LP解值
+    int age_ = 0;                       // 连续处于非基状态的主问题求解次数
+    int protect_flag_ = 0;              // 保护标志: 1=不可清除 (初始列/分支列)
 };
 
 // 节点解: 存储分支定价节点的LP求解结果
@@ -123,13 +176,13 @@ struct NodeSolution {
 // 分支定价节点: 分支定价树中的节点
 struct BPNode {
     // 子问题求解方法
-    int sp1_method_ = 0;        // SP1求解方法: 0=CPLEX, 1=ArcFlow, 2=DP
-    int sp2_method_ = 0;        // SP2求解方法: 0=CPLEX, 1=ArcFlow, 2=DP
+    int sp1_method_ = 0;        // SP1求解方法: 0=CPLEX, 1=ArcFlow, 2=DP, 3=分支定界
+    int sp2_method_ = 0;        // SP2求解方法: 0=CPLEX, 1=ArcFlow, 2=DP, 3=分支定界
 
     // 节点标识
     int id_ = -1;               // 节点编号
     int parent_id_ = -1;        // 父节点编号 (-1表示根节点)
-    double lower_bound_ = -1;   // 节点下界 (LP松弛解)
+    double lower_bound_ = -1;   // 节点下界 (列生成收敛时为LP松弛解, 否则为拉格朗日下界)
 
     // 分支状态
     int branch_dir_ = -1;       // 分支方向: 1=左, 2=右
@@ -146,8 +199,7 @@ struct BPNode {
     vector<int> branched_var_ids_;      // 已分支变量索引
     vector<double> branched_bounds_;    // 已分支变量整数边界
 
-    // 主问题系数矩阵
-    vector<vector<double>> matrix_;             // 完整系数矩阵
+    // 主问题列集合 (系数由方案按需生成稀疏列, 见BuildYColumnCoefs/BuildXColumnCoefs)
     vector<YColumn> y_columns_;                 // Y列集合
     vector<XColumn> x_columns_;                 // X列集合
     vector<set<array<int, 2>>> y_arc_sets_;     // Y列对应的Arc集合
@@ -156,13 +208,29 @@ struct BPNode {
     // 列生成迭代信息
     int iter_ = -1;                     // 当前迭代次数
     vector<double> duals_;              // 对偶价格
-    NewColumn new_y_col_;               // 新Y列
-    NewColumn new_x_col_;               // 新X列
-    int new_strip_type_ = -1;           // 新X列对应的条带类型
-
-    // SP2临时数据
-    double sp2_obj_ = -1;               // SP2目标值
-    vector<double> sp2_solution_;       // SP2解
+    vector<YColumn> new_y_cols_;        // 待加入主问题的新Y列
+    vector<XColumn> new_x_cols_;        // 待加入主问题的新X列 (含所属条带类型)
+
+    // 对偶稳定化状态
+    vector<double> mp_duals_;           // 主问题对偶价格 (稳定化前)
+    vector<double> stab_center_;        // 稳定中心
+    double stab_alpha_ = 0;             // 当前平滑系数
+    double stab_delta_ = 0;             // 当前箱半宽
+    int mispricing_count_ = 0;          // 误定价次数
+
+    double mp_obj_val_ = -1;            // 当前主问题目标值
+
+    // 拉格朗日下界
+    // SP2最优值上界 (INFINITY表示本轮未精确求解)
+    vector<double> sp2_bounds_;
+    double lagrangian_bound_ = -INFINITY;   // 本次列生成得到的最好拉格朗日下界
+
+    // 最终主问题的基状态 (SimplexVarStatus)
+    // 子节点创建时复制父节点的值, 初始主问题从该基出发用对偶单纯形重新优化
+    vector<int> y_basis_status_;        // Y列状态
+    vector<int> x_basis_status_;        // X列状态
+    vector<int> row_basis_status_;      // 约束行剩余变量状态
+    vector<double> parent_duals_;       // 父节点最终对偶价格 (稳定中心初值)
 
     // 节点解
     NodeSolution solution_;             // 求解结果
@@ -171,6 +239,159 @@ struct BPNode {
     BPNode* next_ = nullptr;
 };
 
+// 全局列池: 分支定价过程中生成过的所有列 (按方案去重)
+// 节点定价时先在池中查找负检验数列, 找到则跳过对应子问题
+struct ColumnPool {
+    set<vector<int>> y_keys_;                   // Y列方案集合 (去重)
+    set<pair<int, vector<int>>> x_keys_;        // X列 (条带类型, 方案) 集合 (去重)
+    vector<YColumn> y_cols_;                    // 池中Y列
+    vector<XColumn> x_cols_;                    // 池中X列
+    int oracle_calls_ = 0;                      // 实际调用子问题求解次数
+    int saved_calls_ = 0;                       // 由列池替代的子问题求解次数
+};
+
+// 定价缓存条目: 一组子件价值下SP2精确求解的结果
+struct PricingCacheEntry {
+    uint64_t hash_ = 0;                         // 键的哈希值
+    vector<int64_t> key_;                       // 量化后的子件价值 (精确模式为原始位模式)
+    vector<double> values_;                     // 建立时的子件价值 (宽度不匹配或非正的记为0)
+    double bound_ = INFINITY;                   // SP2最优值上界
+    vector<vector<int>> patterns_;              // 精确求解找到的改进方案
+};
+
+// 定价缓存: 每种条带类型一个, 以相关子件对偶价格的哈希为键
+// 相邻迭代与兄弟节点间多数条带类型的对偶价格几乎不变, 命中时直接复用上次的结果
+// 条目按环形缓冲淘汰最早加入的
+struct PricingCache {
+    unordered_map<uint64_t, int> index_;        // 键哈希 -> 条目编号
+    vector<PricingCacheEntry> entries_;         // 缓存条目
+    int next_slot_ = 0;                         // 缓冲已满时下一个被替换的条目
+    int num_lookups_ = 0;                       // 查询次数
+    int num_hits_ = 0;                          // 命中次数
+
+    // 上界跳过: 最近一次精确求解的子件价值与最优值上界
+    vector<double> last_values_;
+    double last_bound_ = INFINITY;
+    int num_lp_skips_ = 0;                      // 由LP松弛上界跳过的精确求解次数
+    int num_last_skips_ = 0;                    // 由上次求解上界跳过的精确求解次数
+};
+
+// 背包DP工作区 (跨子问题调用复用, 避免反复分配)
+// 只在可达位置上展开, 下标k对应位置raster_->points_[k]
+// 不限数量的物品按完全背包展开, 每个位置只记录最后放入的物品 (回溯指针), 内存O(|P| + n);
+// 有数量上限的物品二进制拆分为0-1物品, 每个位置只记录最后改进它的0-1物品, 内存同为O(|P| + n)
+struct KnapsackDP {
+    vector<int> sizes_;                         // 物品尺寸 (调用方填写)
+    vector<double> values_;                     // 物品价值 (调用方填写, <=0不参与)
+    vector<int> bounds_;                        // 物品数量上限 (调用方填写, INT_MAX=不限)
+    const RasterPoints* raster_ = nullptr;      // 本次求解使用的可达位置
+    vector<double> dp_;                         // dp_[k] = 占用不超过points_[k]时的最大价值
+    vector<int> best_point_;                    // dp_[k]对应方案恰好占用的位置下标
+    vector<int> last_item_;                     // 完全背包阶段恰好占用points_[k]的最优方案最后放入的物品 (-1=空方案)
+    double dp_error_ = 0.0;                     // dp_相对真实价值的最大低估量 (双精度内核为0)
+
+    // 有界物品的二进制拆分 (0-1物品按拆分顺序在完全背包阶段之后展开)
+    vector<int> piece_items_;                   // 0-1物品所属的物品
+    vector<int> piece_counts_;                  // 0-1物品包含的件数 (嵌套DP中0表示不限数量)
+    vector<int> last_piece_;                    // last_piece_[k] = 最后一次严格改进位置k的0-1物品 (-1=无)
+    vector<double> piece_base_dp_;              // 0-1物品展开前的dp (回溯时按需重放)
+    vector<double> nested_dp_;                  // 嵌套DP工作表 (件数0的阶段为完全背包)
+
+    // 按gcd缩放后的稠密网格 (定点内核, 及可达位置稠密时的双精度完全背包阶段)
+    vector<int32_t> fixed_dp_;                  // 定点价值 (不可达位置为极小值)
+    vector<int32_t> fixed_last_;                // 最后放入的物品 (两种内核共用)
+    vector<double> grid_dp_;                    // 双精度价值 (占用不超过该格点)
+    bool grid_last_ = false;                    // 完全背包阶段的回溯指针在网格fixed_last_上
+    int num_fixed_solves_ = 0;                  // 定点内核求解次数
+    int num_exact_fallbacks_ = 0;               // 舍入误差无法判定, 回退双精度的次数
+};
+
+// 背包分支定界工作区 (跨子问题调用复用)
+// 搜索代价只与物品数和搜索节点数有关, 与容量无关
+struct KnapsackBB {
+    vector<int> sizes_;                         // 物品尺寸 (调用方填写)
+    vector<double> values_;                     // 物品价值 (调用方填写, <=0不参与)
+    vector<int> bounds_;                        // 物品数量上限 (调用方填写, INT_MAX=不限)
+
+    vector<int> order_;                         // 参与搜索的物品 (按价值密度降序)
+    vector<int> counts_;                        // 搜索中的当前方案 (按order_下标)
+    vector<int> suffix_min_size_;               // order_[k..]中的最小尺寸
+    vector<pair<double, vector<int>>> best_;    // 已找到的最优方案 (价值降序, 至多k个)
+    double max_pruned_bound_ = 0.0;             // 被剪枝节点上界与叶子价值的最大值
+    long long num_nodes_ = 0;                   // 本次搜索节点数
+    int num_solves_ = 0;                        // 累计求解次数
+    int num_node_limit_hits_ = 0;               // 节点数超限 (回退DP) 次数
+};
+
+// 定价工作区: 子问题求解使用的缓冲区与统计 (每个定价线程一份, 互不共享)
+struct PricingWorkspace {
+    KnapsackDP knapsack_dp_;            // 背包DP工作区
+    KnapsackBB knapsack_bb_;            // 背包分支定界工作区
+    int num_heuristic_hits_ = 0;        // 启发式定价找到改进列 (免去精确求解) 的次数
+};
+
+// 内置单纯形LP: min c'x, s.t. Ax >= b, 0 <= x <= u
+// 每行引入剩余变量 (系数-1) 与人工变量 (系数+1, 大M费用), 变量编号:
+//   0 ~ m-1: 剩余变量, m ~ 2m-1: 人工变量, 2m起: 结构变量 (按加入顺序)
+// 基逆矩阵B^-1稠密存储 (m = J+N较小), 换基时秩1更新, 定期重新分解
+struct SimplexLP {
+    int num_rows_ = 0;                          // 约束行数 (m)
+    vector<double> rhs_;                        // 右端项b
+    vector<SparseColumn> cols_;                 // 稀疏列
+    vector<double> costs_;                      // 目标系数
+    vector<double> ubs_;                        // 变量上界
+    vector<int> status_;                        // 变量状态 (SimplexVarStatus)
+    vector<int> basis_;                         // basis_[r] = 第r行的基变量
+    vector<double> basis_inv_;                  // B^-1 (m*m, 行优先)
+    vector<double> x_basic_;                    // 基变量取值
+    vector<double> duals_;                      // 对偶价格
+    double obj_val_ = 0.0;                      // 目标值
+    int num_pivots_ = 0;                        // 上次分解后的换基次数
+    int total_iters_ = 0;                       // 累计换基次数
+};
+
+// 主问题LP: 一次列生成过程中持久存在的模型
+// 新列增量加入, 再次求解时从上一次的最优基出发 (primal simplex)
+// CPLEX与内置单纯形法两种后端, 由method_选择, 求解结果统一写入下方向量
+struct MasterLP {
+    int method_ = kMPCplex;             // 求解后端 (MPMethod)
+    int dual_mode_ = kVertexDuals;      // 对偶价格类型 (DualMode)
+
+    // 求解结果 (与node.y_columns_/x_columns_一一对应)
+    double obj_val_ = 0.0;              // 目标值
+    vector<double> y_values_;           // Y列取值
+    vector<double> x_values_;           // X列取值
+    vector<double> y_rcs_;              // Y列检验数
+    vector<double> x_rcs_;              // X列检验数
+    vector<double> y_ubs_;              // Y列上界 (分支约束)
+    vector<double> x_ubs_;              // X列上界 (分支约束)
+
+#ifndef CS_NO_CPLEX
+    // CPLEX后端
+    IloEnv env_;                        // CPLEX环境
+    IloModel model_;                    // 主问题模型
+    IloObjective obj_;                  // 目标函数 (min sum y_k)
+    IloRangeArray cons_;                // 约束: 条带平衡 (J行) + 子件需求 (N行)
+    IloNumVarArray y_vars_;             // Y列变量
+    IloNumVarArray x_vars_;             // X列变量
+    IloCplex cplex_;                    // 持久求解器
+#endif
+
+    // 热启动基 (CPLEX后端在首次求解提取模型后载入)
+    vector<int> start_col_status_;      // 列状态 (Y列在前, X列在后)
+    vector<int> start_row_status_;      // 约束行状态
+
+    // 内置单纯形法后端
+    SimplexLP simplex_;                 // LP数据与当前基
+    vector<int> y_var_ids_;             // Y列对应的单纯形变量编号 (CPLEX后端为-1)
+    vector<int> x_var_ids_;             // X列对应的单纯形变量编号 (CPLEX后端为-1)
+
+    // 求解统计
+    int solve_count_ = 0;               // 求解次数
+    double solve_time_ = 0.0;           // 累计求解耗时 (秒)
+    double last_solve_time_ = 0.0;      // 最近一次求解耗时 (秒)
+};
+
 // 问题参数: 存储算法运行过程中的全局参数
 struct ProblemParams {
     // 问题规模
@@ -185,6 +406,35 @@ struct ProblemParams {
     // 子问题方法设置
     int sp1_method_ = kCplexIP;         // SP1默认方法
     int sp2_method_ = kCplexIP;         // SP2默认方法
+    int mp_method_ = kMPCplex;          // 主问题LP求解后端
+    int dual_mode_ = kVertexDuals;      // 定价使用的对偶价格类型
+    int pricing_mode_ = kSequentialPricing;  // 定价轮次模式
+    int max_cols_per_sp_ = 1;           // 每次子问题求解最多加入的改进列数 (k)
+
+    // 对偶稳定化设置 (仅批量定价模式生效)
+    int stab_mode_ = kNoStabilization;  // 稳定化模式
+    double stab_alpha_ = 0.5;           // Wentges平滑系数初值
+    double stab_delta_ = 0.1;           // Box-step箱半宽初值
+
+    // 列管理设置
+    int column_max_age_ = 0;            // 列连续非基次数达到该值时清除 (0=不清除)
+    int num_purged_cols_ = 0;           // 累计清除列数
+    bool use_column_pool_ = false;      // 定价前先扫描全局列池
+    ColumnPool column_pool_;            // 全局列池
+    int dp_kernel_ = kDPExact;          // DP背包内核
+    bool demand_bounded_ = false;       // 定价方案中子件/条带数量不超过需求上界
+    bool heuristic_pricing_ = false;    // SP2先用贪心启发式定价, 找不到改进列时再调用精确方法
+    bool pricing_cache_ = false;        // SP2定价缓存: 对偶价格未变时复用上次的求解结果
+    double pricing_cache_quantum_ = 0.0;    // 缓存键量化步长 (0=精确匹配, >0=按步长量化, 命中时计入误差上界)
+    int pricing_cache_size_ = 64;       // 每种条带类型的缓存条目数
+    vector<PricingCache> pricing_caches_;   // 定价缓存 (每种条带类型一个)
+    bool sp2_bound_skip_ = false;       // SP2上界 (LP松弛/上次求解) 不超过v_j时跳过精确求解
+    bool nested_sp2_dp_ = false;        // SP2为DP时各条带类型共用一张嵌套DP表, 一次扫描求解 (仅批量定价模式)
+    bool resident_sp_models_ = false;   // CPLEX子问题模型常驻 (只更新目标系数), 解池一次提取多列, 并行时单线程求解
+
+    // 并行定价设置 (仅批量定价模式生效)
+    int num_pricing_threads_ = 1;       // SP2定价线程数 (1=串行, 0=硬件线程数)
+    vector<PricingWorkspace> workspaces_;   // 定价工作区 ([0]为主线程, 其余为线程池线程)
 
     // 分支定价树
     int node_counter_ = 1;              // 节点编号计数器
@@ -201,6 +451,22 @@ struct ProblemParams {
     vector<vector<int>> init_x_matrix_;         // 初始X列矩阵
 };
 
+#ifndef CS_NO_CPLEX
+// 常驻CPLEX子问题模型: 首次求解时建立, 此后每次定价只更新目标系数
+// 变量、约束与数量上界只与实例有关, 不随对偶价格变化, 无需每次重建
+// 每个模型使用独立的CPLEX环境, 不同条带类型的SP2可在定价线程中并行求解
+struct CplexSPModel {
+    IloEnv env_;                        // CPLEX环境
+    IloModel model_;                    // 子问题模型
+    IloNumVarArray vars_;               // 变量 (背包: 每种条带/子件一个; Arc Flow: 每条Arc一个)
+    IloObjective obj_;                  // 目标函数 (max, 系数每次更新)
+    IloCplex cplex_;                    // 持久求解器
+    IloNumArray obj_coefs_;             // 目标系数缓冲 (与vars_等长)
+    vector<int> var_types_;             // 变量对应的条带/子件类型 (-1表示价值恒为0)
+    int solve_count_ = 0;               // 求解次数
+};
+#endif
+
 // 问题数据: 存储问题的输入数据和Arc Flow模型数据
 struct ProblemData {
     // 基本数据
@@ -215,12 +481,32 @@ struct ProblemData {
     map<int, vector<int>> width_to_item_indices_;  // 宽度到该宽度的子件类型列表
 
     // SP1 Arc Flow网络 (宽度方向)
-    SP1ArcFlowData sp1_arc_data_;
+    ArcFlowGraph sp1_arc_data_;
 
     // SP2 Arc Flow网络 (长度方向, 每种条带类型一个)
-    vector<SP2ArcFlowData> sp2_arc_data_;
+    vector<ArcFlowGraph> sp2_arc_data_;
+
+    // 可达位置 (SP1宽度方向, SP2每种条带类型一个; 首次被DP或Arc Flow使用时生成, 未生成时为空)
+    RasterPoints sp1_raster_;
+    vector<RasterPoints> sp2_raster_;
+
+#ifndef CS_NO_CPLEX
+    // 常驻CPLEX子问题模型 (首次使用时建立, SP2每种条带类型一个)
+    unique_ptr<CplexSPModel> sp1_knapsack_model_;
+    unique_ptr<CplexSPModel> sp1_arc_model_;
+    vector<unique_ptr<CplexSPModel>> sp2_knapsack_models_;
+    vector<unique_ptr<CplexSPModel>> sp2_arc_models_;
+#endif
 };
 
+// 可达位置函数 (raster_points.cpp)
+void ComputeRasterPoints(const vector<int>& sizes, int capacity, RasterPoints& raster);
+void InitRasterPoints(ProblemData& data, ProblemParams& params);
+const RasterPoints& GetSP1Raster(ProblemData& data, ProblemParams& params);
+const RasterPoints& GetSP2Raster(ProblemData& data, ProblemParams& params, int strip_type_id);
+int FindFloorPoint(const RasterPoints& raster, int pos);
+int FindPoint(const RasterPoints& raster, int pos);
+
 // Arc Flow函数 (arc_flow.cpp)
 void GenerateSP1Arcs(ProblemData& data, ProblemParams& params);
 void GenerateSP2Arcs(ProblemData& data, ProblemParams& params, int strip_type_id);
@@ -246,56 +532,73 @@ void PrintNodeInfo(BPNode* node);
 // 启发式函数 (heuristic.cpp)
 void RunHeuristic(ProblemParams& params, ProblemData& data, BPNode& root_node);
 
+// 主问题LP函数 (master_problem.cpp)
+void InitMasterLP(ProblemParams& params, ProblemData& data, MasterLP& mp);
+SparseColumn BuildYColumnCoefs(ProblemParams& params, const vector<int>& pattern);
+SparseColumn BuildXColumnCoefs(ProblemParams& params, int strip_type,
+    const vector<int>& pattern);
+void AddYColumnToMP(ProblemParams& params, MasterLP& mp,
+    const vector<int>& pattern, double var_ub, int col_id);
+void AddXColumnToMP(ProblemParams& params, MasterLP& mp,
+    int strip_type, const vector<int>& pattern, double var_ub, int col_id);
+bool SolveMasterLP(ProblemParams& params, MasterLP& mp, BPNode& node);
+void RemoveColumnsFromMP(MasterLP& mp, vector<int>& y_flags, vector<int>& x_flags);
+void SaveMasterBasis(MasterLP& mp, BPNode& node);
+bool LoadMasterBasis(MasterLP& mp, BPNode& node);
+void EndMasterLP(MasterLP& mp);
+
+// 内置单纯形法函数 (simplex.cpp)
+void InitSimplexLP(SimplexLP& lp, const vector<double>& rhs);
+int AddSimplexColumn(SimplexLP& lp, const SparseColumn& col,
+    double cost, double ub);
+vector<int> RemoveSimplexColumns(SimplexLP& lp, const vector<int>& remove_flags);
+bool SetSimplexBasis(SimplexLP& lp, const vector<int>& status);
+bool SolveSimplexLP(SimplexLP& lp);
+void GetSimplexValues(SimplexLP& lp, vector<double>& values);
+double GetSimplexReducedCost(SimplexLP& lp, int var);
+
+// 列管理函数 (column_manager.cpp)
+int ManageColumns(ProblemParams& params, MasterLP& mp, BPNode& node);
+
+// 全局列池函数 (column_pool.cpp)
+void AddYColumnToPool(ProblemParams& params, const YColumn& y_col);
+void AddXColumnToPool(ProblemParams& params, const XColumn& x_col);
+int ScanPoolForYColumns(ProblemParams& params, BPNode& node);
+int ScanPoolForXColumns(ProblemParams& params, BPNode& node, int strip_type_id);
+
 // 根节点列生成函数 (root_node.cpp)
 void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node);
 bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode& root_node);
+    MasterLP& mp, BPNode& root_node);
 bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode& node);
+    MasterLP& mp, BPNode& node);
 bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode& node);
-
-// 根节点子问题函数 (root_node_sub.cpp)
-// SP1: 宽度背包 - 选择条带放置在母板上
-// 目标: max sum(v_j * G_j), 约束: sum(w_j * G_j) <= W
-bool SolveRootSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode& node);
-bool SolveRootSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode& node);
-bool SolveRootSP1DP(ProblemParams& params, ProblemData& data, BPNode& node);
-
-// SP2: 长度背包 - 选择子件放置在条带上
-// 目标: max sum(pi_i * D_i), 约束: sum(l_i * D_i) <= L
-bool SolveRootSP2Knapsack(ProblemParams& params, ProblemData& data,
-    BPNode& node, int strip_type_id);
-bool SolveRootSP2ArcFlow(ProblemParams& params, ProblemData& data,
-    BPNode& node, int strip_type_id);
-bool SolveRootSP2DP(ProblemParams& params, ProblemData& data,
-    BPNode& node, int strip_type_id);
+    MasterLP& mp, BPNode& node);
 
 // 非根节点列生成函数 (new_node.cpp)
 int SolveNodeCG(ProblemParams& params, ProblemData& data, BPNode* node);
 bool SolveNodeInitMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node);
+    MasterLP& mp, BPNode* node);
 bool SolveNodeUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node);
+    MasterLP& mp, BPNode* node);
 bool SolveNodeFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode* node);
-
-// 非根节点子问题函数 (new_node_sub.cpp)
-bool SolveNodeSP1Knapsack(ProblemParams& params, ProblemData& data, BPNode* node);
-bool SolveNodeSP1ArcFlow(ProblemParams& params, ProblemData& data, BPNode* node);
-bool SolveNodeSP1DP(ProblemParams& params, ProblemData& data, BPNode* node);
-bool SolveNodeSP2Knapsack(ProblemParams& params, ProblemData& data,
-    BPNode* node, int strip_type_id);
-bool SolveNodeSP2ArcFlow(ProblemParams& params, ProblemData& data,
-    BPNode* node, int strip_type_id);
-bool SolveNodeSP2DP(ProblemParams& params, ProblemData& data,
+    MasterLP& mp, BPNode* node);
+
+// 定价引擎函数 (pricing_engine.cpp)
+// SP1: 宽度背包 - 选择条带放置在母板上
+// 目标: max sum(v_j * G_j), 约束: sum(w_j * G_j) <= W
+// SP2: 长度背包 - 选择子件放置在条带上
+// 目标: max sum(pi_i * D_i), 约束: sum(l_i * D_i) <= L
+// 按节点设置的求解方法 (CPLEX/Arc Flow/DP/分支定界) 求解, 返回: true=收敛, false=找到改进列
+bool SolveRootSP1Exact(ProblemParams& params, ProblemData& data, BPNode& node);
+bool SolveNodeSP1Exact(ProblemParams& params, ProblemData& data, BPNode* node);
+bool SolveRootSP2Exact(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id);
+bool SolveNodeSP2Exact(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id);
+// 以给定条带价值求SP1最优值的上界 (不加入列), 大于threshold时为精确最优值
+double SolveSP1Value(ProblemParams& params, ProblemData& data, BPNode& node,
+    const vector<double>& strip_values, double threshold);
 
 // 列生成主流程函数 (column_generation.cpp)
 bool SolveRootSP1(ProblemParams& params, ProblemData& data, BPNode& node);
@@ -305,6 +608,99 @@ bool SolveNodeSP1(ProblemParams& params, ProblemData& data, BPNode* node);
 bool SolveNodeSP2(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id);
 
+// 批量定价轮次 (column_generation.cpp)
+bool SolvePricingRound(ProblemParams& params, ProblemData& data,
+    BPNode& node, bool is_root);
+
+// 拉格朗日下界函数 (column_generation.cpp)
+double ComputeLagrangianBound(ProblemParams& params, ProblemData& data, BPNode& node);
+int CheckLagrangianTermination(ProblemParams& params, BPNode& node);
+void UpdateNodeLowerBound(ProblemParams& params, BPNode& node, bool cg_converged);
+
+// 多列提取函数 (column_generation.cpp)
+#ifndef CS_NO_CPLEX
+bool SolveSPModel(ProblemParams& params, IloCplex& cplex);
+vector<int> CollectImprovingSolutions(ProblemParams& params, IloCplex& cplex,
+    double threshold);
+#endif
+
+// 需求上界函数 (column_generation.cpp)
+int ItemCountBound(ProblemParams& params, ProblemData& data, int item_type_id);
+int StripCountBound(ProblemParams& params, ProblemData& data, int strip_type_id);
+#ifndef CS_NO_CPLEX
+void AddSP1ArcCountBounds(ProblemParams& params, ProblemData& data,
+    IloModel& model, IloNumVarArray& vars);
+void AddSP2ArcCountBounds(ProblemParams& params, ProblemData& data,
+    int strip_type_id, IloModel& model, IloNumVarArray& vars);
+#endif
+
+// 常驻子问题模型函数 (sp_models.cpp)
+#ifndef CS_NO_CPLEX
+CplexSPModel& GetSP1KnapsackModel(ProblemParams& params, ProblemData& data);
+CplexSPModel& GetSP1ArcFlowModel(ProblemParams& params, ProblemData& data);
+CplexSPModel& GetSP2KnapsackModel(ProblemParams& params, ProblemData& data,
+    int strip_type_id);
+CplexSPModel& GetSP2ArcFlowModel(ProblemParams& params, ProblemData& data,
+    int strip_type_id);
+void PrepareSP2Models(ProblemParams& params, ProblemData& data);
+void SetSPObjective(CplexSPModel& sp, const vector<double>& type_values);
+void EndSPModels(ProblemData& data);
+#endif
+
+// 背包DP函数 (knapsack.cpp)
+void PrepareKnapsackDP(KnapsackDP& kp, int num_items);
+double SolveKnapsackDP(ProblemParams& params, KnapsackDP& kp,
+    const RasterPoints& raster, double threshold);
+void RebuildDPPattern(const KnapsackDP& kp, int point, vector<int>& pattern);
+void ExtractDPPatterns(ProblemParams& params, const KnapsackDP& kp,
+    double threshold, vector<vector<int>>& patterns);
+void BeginNestedDP(KnapsackDP& kp, const RasterPoints& raster, int num_items);
+void AddNestedDPItem(KnapsackDP& kp, int i);
+double ReadNestedDP(KnapsackDP& kp);
+
+// 嵌套DP函数 (nested_sp2_dp.cpp)
+void SolveNestedSP2DP(ProblemParams& params, ProblemData& data, BPNode& node,
+    const vector<int>& strip_ids, vector<vector<vector<int>>>& patterns);
+
+// 背包分支定界函数 (knapsack_bb.cpp)
+void PrepareKnapsackBB(KnapsackBB& kb, int num_items);
+bool SolveKnapsackBB(ProblemParams& params, KnapsackBB& kb, int capacity,
+    double threshold, double& opt_val, vector<vector<int>>& patterns);
+
+// 启发式定价函数 (pricing_heuristic.cpp)
+int PriceSP2Heuristic(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id);
+
+// 定价缓存函数 (pricing_cache.cpp)
+void InitPricingCache(ProblemParams& params);
+bool LookupPricingCache(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, bool& cg_converged);
+void StorePricingCache(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, int first_col);
+bool SkipSP2ByBound(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id);
+void RecordSP2Bound(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id);
+
+// 并行定价函数 (pricing_pool.cpp)
+void InitPricingPool(ProblemParams& params);
+int GetNumPricingThreads();
+PricingWorkspace& GetPricingWorkspace(ProblemParams& params);
+void RunPricingTasks(int num_tasks, const function<void(int)>& task);
+
+// 定点SIMD背包内核 (knapsack_simd.cpp)
+int DetectSimdLevel();
+const char* SimdLevelName(int level);
+void RelaxFixedItem(int simd_level, int32_t* dp, int32_t* last, int num_cells,
+    int size, int32_t value, int32_t item);
+
+// 对偶稳定化函数 (stabilization.cpp)
+void InitDualStabilization(ProblemParams& params, BPNode& node);
+bool StabilizeDuals(ProblemParams& params, BPNode& node);
+int CountImprovingColumns(ProblemParams& params, BPNode& node,
+    const vector<double>& duals);
+bool DetectMispricing(ProblemParams& params, BPNode& node);
+
 // 分支定价函数 (branch_and_price.cpp)
 bool IsIntegerSolution(NodeSolution& solution);
 int SelectBranchVar(BPNode* node);
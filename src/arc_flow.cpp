@@ -6,193 +6,139 @@
 
 using namespace std;
 
-// 生成SP1的Arc Flow网络 (宽度方向)
-// 节点: 母板宽度方向上的位置 (0到stock_width)
-// Arc: 放置一种条带类型, Arc长度等于条带宽度
-void GenerateSP1Arcs(ProblemData& data, ProblemParams& params) {
-    LOG("[Arc Flow] 生成SP1网络 (宽度方向)");
-
-    SP1ArcFlowData& arc_data = data.sp1_arc_data_;
-    arc_data.arc_list_.clear();
-    arc_data.arc_to_index_.clear();
-    arc_data.begin_nodes_.clear();
-    arc_data.end_nodes_.clear();
-    arc_data.mid_nodes_.clear();
-    arc_data.begin_arc_indices_.clear();
-    arc_data.end_arc_indices_.clear();
-    arc_data.mid_in_arcs_.clear();
-    arc_data.mid_out_arcs_.clear();
-
-    int stock_width = params.stock_width_;
-    int num_strip_types = params.num_strip_types_;
-
-    // 收集所有可能的节点位置
-    set<int> node_set;
-    node_set.insert(0);
-    node_set.insert(stock_width);
-
-    // 生成所有可能的Arc
-    for (int start = 0; start <= stock_width; start++) {
-        for (int j = 0; j < num_strip_types; j++) {
-            int strip_width = data.strip_types_[j].width_;
-            int end = start + strip_width;
-
-            if (end <= stock_width) {
-                array<int, 2> arc = {start, end};
-                if (arc_data.arc_to_index_.find(arc) == arc_data.arc_to_index_.end()) {
-                    int idx = static_cast<int>(arc_data.arc_list_.size());
-                    arc_data.arc_to_index_[arc] = idx;
-                    arc_data.arc_list_.push_back(arc);
-                    node_set.insert(start);
-                    node_set.insert(end);
-                }
-            }
+// 在可达位置上构建Arc Flow网络, 时间与 (节点数 + Arc数) 成正比
+// items: (尺寸, 物品类型下标), 尺寸相同的物品合并为一组, 共用一条放置弧
+// 放置弧: 可达位置p到p + s (s为物品尺寸, 不超过容量). 可达位置对加尺寸封闭, p + s必为节点
+// 损耗弧: 每个可达位置直连终点capacity, 使方案不必恰好填满
+//         (与放置弧端点相同时不重复加入, 放置弧价值非负, 优于损耗弧)
+static void BuildArcFlowGraph(ArcFlowGraph& graph, const RasterPoints& raster,
+    vector<pair<int, int>> items, int capacity) {
+
+    // 物品按尺寸升序分组
+    sort(items.begin(), items.end());
+    vector<int> group_sizes;
+    vector<int> group_offsets;
+    vector<int> group_items;
+    for (auto& [size, item] : items) {
+        if (size <= 0 || size > capacity) continue;
+        if (group_sizes.empty() || group_sizes.back() != size) {
+            group_sizes.push_back(size);
+            group_offsets.push_back(static_cast<int>(group_items.size()));
         }
+        group_items.push_back(item);
     }
-
-    // 分类节点
-    arc_data.begin_nodes_.push_back(0);
-    arc_data.end_nodes_.push_back(stock_width);
-
-    for (int node : node_set) {
-        if (node != 0 && node != stock_width) {
-            arc_data.mid_nodes_.push_back(node);
-        }
+    group_offsets.push_back(static_cast<int>(group_items.size()));
+    int num_groups = static_cast<int>(group_sizes.size());
+
+    // 节点: 可达位置, 终点capacity不可达时追加在末尾
+    graph.capacity_ = capacity;
+    graph.node_pos_ = raster.points_;
+    if (graph.node_pos_.empty() || graph.node_pos_.back() != capacity) {
+        graph.node_pos_.push_back(capacity);
     }
-
-    // 分类Arc
-    int num_mid = static_cast<int>(arc_data.mid_nodes_.size());
-    arc_data.mid_in_arcs_.resize(num_mid);
-    arc_data.mid_out_arcs_.resize(num_mid);
-
-    for (int idx = 0; idx < static_cast<int>(arc_data.arc_list_.size()); idx++) {
-        int start = arc_data.arc_list_[idx][0];
-        int end = arc_data.arc_list_[idx][1];
-
-        // 起点Arc
-        if (start == 0) {
-            arc_data.begin_arc_indices_.push_back(idx);
+    int num_nodes = static_cast<int>(graph.node_pos_.size());
+    int end_node = num_nodes - 1;
+
+    graph.arc_tail_.clear();
+    graph.arc_head_.clear();
+    graph.arc_item_offsets_.clear();
+    graph.arc_items_.clear();
+    graph.out_offsets_.assign(num_nodes + 1, 0);
+
+    auto add_arc = [&graph](int tail, int head) {
+        graph.arc_tail_.push_back(tail);
+        graph.arc_head_.push_back(head);
+        graph.arc_item_offsets_.push_back(static_cast<int>(graph.arc_items_.size()));
+    };
+
+    // 出弧 (按起点升序生成, 即为CSR顺序); 各组的弧头随起点单调右移, 用指针推进查找
+    vector<int> group_head(num_groups, 0);
+    for (int v = 0; v < end_node; v++) {
+        graph.out_offsets_[v] = static_cast<int>(graph.arc_tail_.size());
+        int pos = graph.node_pos_[v];
+
+        bool reaches_end = false;
+        for (int g = 0; g < num_groups; g++) {
+            int head_pos = pos + group_sizes[g];
+            if (head_pos > capacity) break;
+
+            int& head = group_head[g];
+            while (graph.node_pos_[head] < head_pos) head++;
+            add_arc(v, head);
+            graph.arc_items_.insert(graph.arc_items_.end(),
+                group_items.begin() + group_offsets[g], group_items.begin() + group_offsets[g + 1]);
+            reaches_end = reaches_end || head == end_node;
         }
-
-        // 终点Arc
-        if (end == stock_width) {
-            arc_data.end_arc_indices_.push_back(idx);
+        if (!reaches_end) {
+            add_arc(v, end_node);
+            graph.arc_items_.push_back(-1);
         }
+    }
+    int num_arcs = static_cast<int>(graph.arc_tail_.size());
+    graph.out_offsets_[end_node] = num_arcs;
+    graph.out_offsets_[num_nodes] = num_arcs;
+    graph.arc_item_offsets_.push_back(static_cast<int>(graph.arc_items_.size()));
+
+    // 入弧 (按终点计数排序)
+    graph.in_offsets_.assign(num_nodes + 1, 0);
+    for (int a = 0; a < num_arcs; a++) {
+        graph.in_offsets_[graph.arc_head_[a] + 1]++;
+    }
+    for (int v = 0; v < num_nodes; v++) {
+        graph.in_offsets_[v + 1] += graph.in_offsets_[v];
+    }
+    graph.in_arcs_.resize(num_arcs);
+    vector<int> fill(graph.in_offsets_.begin(), graph.in_offsets_.end() - 1);
+    for (int a = 0; a < num_arcs; a++) {
+        graph.in_arcs_[fill[graph.arc_head_[a]]++] = a;
+    }
+}
 
-        // 中间节点的入弧和出弧
-        for (int i = 0; i < num_mid; i++) {
-            int mid_node = arc_data.mid_nodes_[i];
-            if (end == mid_node) {
-                arc_data.mid_in_arcs_[i].push_back(idx);
-            }
-            if (start == mid_node) {
-                arc_data.mid_out_arcs_[i].push_back(idx);
-            }
-        }
+// 生成SP1的Arc Flow网络 (宽度方向)
+// 节点: 条带宽度组合可达的位置, Arc: 放置一种条带 (长度等于条带宽度) 或损耗弧
+void GenerateSP1Arcs(ProblemData& data, ProblemParams& params) {
+    LOG("[Arc Flow] 生成SP1网络 (宽度方向)");
+
+    int num_strip_types = params.num_strip_types_;
+    vector<pair<int, int>> strip_widths(num_strip_types);
+    for (int j = 0; j < num_strip_types; j++) {
+        strip_widths[j] = {data.strip_types_[j].width_, j};
     }
 
-    LOG_FMT("  节点数: %d (起点1, 终点1, 中间%d)\n",
-        (int)node_set.size(), num_mid);
-    LOG_FMT("  Arc数: %d\n", (int)arc_data.arc_list_.size());
+    ArcFlowGraph& graph = data.sp1_arc_data_;
+    BuildArcFlowGraph(graph, GetSP1Raster(data, params), strip_widths, params.stock_width_);
+
+    int num_nodes = static_cast<int>(graph.node_pos_.size());
+    LOG_FMT("  节点数: %d (起点1, 终点1, 中间%d)\n", num_nodes, num_nodes - 2);
+    LOG_FMT("  Arc数: %d\n", (int)graph.arc_tail_.size());
 }
 
 // 生成SP2的Arc Flow网络 (长度方向)
-// 节点: 条带长度方向上的位置 (0到stock_length)
-// Arc: 放置一种子件, Arc长度等于子件长度
+// 节点: 子件长度组合可达的位置, Arc: 放置一个子件 (长度等于子件长度) 或损耗弧
 // 仅考虑宽度匹配的子件类型
 void GenerateSP2Arcs(ProblemData& data, ProblemParams& params, int strip_type_id) {
     LOG_FMT("[Arc Flow] 生成SP2网络 (条带类型%d)\n", strip_type_id);
 
     // 确保sp2_arc_data_有足够空间
     while ((int)data.sp2_arc_data_.size() <= strip_type_id) {
-        data.sp2_arc_data_.push_back(SP2ArcFlowData());
+        data.sp2_arc_data_.push_back(ArcFlowGraph());
     }
 
-    SP2ArcFlowData& arc_data = data.sp2_arc_data_[strip_type_id];
-    arc_data.strip_type_id_ = strip_type_id;
-    arc_data.arc_list_.clear();
-    arc_data.arc_to_index_.clear();
-    arc_data.begin_nodes_.clear();
-    arc_data.end_nodes_.clear();
-    arc_data.mid_nodes_.clear();
-    arc_data.begin_arc_indices_.clear();
-    arc_data.end_arc_indices_.clear();
-    arc_data.mid_in_arcs_.clear();
-    arc_data.mid_out_arcs_.clear();
-
-    int stock_length = params.stock_length_;
     int strip_width = data.strip_types_[strip_type_id].width_;
-    int num_item_types = params.num_item_types_;
-
-    // 收集所有可能的节点位置
-    set<int> node_set;
-    node_set.insert(0);
-    node_set.insert(stock_length);
-
-    // 生成所有可能的Arc (仅考虑宽度匹配的子件)
-    for (int start = 0; start <= stock_length; start++) {
-        for (int i = 0; i < num_item_types; i++) {
-            int item_width = data.item_types_[i].width_;
-            int item_length = data.item_types_[i].length_;
-
-            // 子件宽度必须小于等于条带宽度
-            if (item_width <= strip_width) {
-                int end = start + item_length;
-
-                if (end <= stock_length) {
-                    array<int, 2> arc = {start, end};
-                    if (arc_data.arc_to_index_.find(arc) == arc_data.arc_to_index_.end()) {
-                        int idx = static_cast<int>(arc_data.arc_list_.size());
-                        arc_data.arc_to_index_[arc] = idx;
-                        arc_data.arc_list_.push_back(arc);
-                        node_set.insert(start);
-                        node_set.insert(end);
-                    }
-                }
-            }
-        }
-    }
-
-    // 分类节点
-    arc_data.begin_nodes_.push_back(0);
-    arc_data.end_nodes_.push_back(stock_length);
-
-    for (int node : node_set) {
-        if (node != 0 && node != stock_length) {
-            arc_data.mid_nodes_.push_back(node);
+    vector<pair<int, int>> item_lengths;
+    for (int i = 0; i < params.num_item_types_; i++) {
+        // 子件宽度必须小于等于条带宽度
+        if (data.item_types_[i].width_ <= strip_width) {
+            item_lengths.push_back({data.item_types_[i].length_, i});
         }
     }
 
-    // 分类Arc
-    int num_mid = static_cast<int>(arc_data.mid_nodes_.size());
-    arc_data.mid_in_arcs_.resize(num_mid);
-    arc_data.mid_out_arcs_.resize(num_mid);
-
-    for (int idx = 0; idx < static_cast<int>(arc_data.arc_list_.size()); idx++) {
-        int start = arc_data.arc_list_[idx][0];
-        int end = arc_data.arc_list_[idx][1];
-
-        if (start == 0) {
-            arc_data.begin_arc_indices_.push_back(idx);
-        }
-
-        if (end == stock_length) {
-            arc_data.end_arc_indices_.push_back(idx);
-        }
-
-        for (int i = 0; i < num_mid; i++) {
-            int mid_node = arc_data.mid_nodes_[i];
-            if (end == mid_node) {
-                arc_data.mid_in_arcs_[i].push_back(idx);
-            }
-            if (start == mid_node) {
-                arc_data.mid_out_arcs_[i].push_back(idx);
-            }
-        }
-    }
+    ArcFlowGraph& graph = data.sp2_arc_data_[strip_type_id];
+    BuildArcFlowGraph(graph, GetSP2Raster(data, params, strip_type_id), item_lengths,
+        params.stock_length_);
 
     LOG_FMT("  节点数: %d, Arc数: %d\n",
-        (int)node_set.size(), (int)arc_data.arc_list_.size());
+        (int)graph.node_pos_.size(), (int)graph.arc_tail_.size());
 }
 
 // 生成所有Arc Flow网络
@@ -79,6 +79,16 @@ int SelectBranchVar(BPNode* node) {
     return branch_idx;
 }
 
+// 标记分支变量对应的列为受保护 (列清除时保留)
+static void ProtectBranchColumn(BPNode* child, int var_id) {
+    int num_y_cols = static_cast<int>(child->y_columns_.size());
+    if (var_id < num_y_cols) {
+        child->y_columns_[var_id].protect_flag_ = 1;
+    } else {
+        child->x_columns_[var_id - num_y_cols].protect_flag_ = 1;
+    }
+}
+
 // 创建左子节点 (向下取整分支)
 void CreateLeftChild(BPNode* parent, int new_id, BPNode* child) {
     // 复制基本信息
@@ -87,17 +97,25 @@ void CreateLeftChild(BPNode* parent, int new_id, BPNode* child) {
     child->branch_dir_ = 1;  // 左分支
     child->sp1_method_ = parent->sp1_method_;
     child->sp2_method_ = parent->sp2_method_;
+    child->lower_bound_ = parent->lower_bound_;  // 子节点下界不低于父节点
 
     // 复制列集合
     child->y_columns_ = parent->y_columns_;
     child->x_columns_ = parent->x_columns_;
 
+    // 继承父节点最终主问题的基与对偶价格 (热启动)
+    child->y_basis_status_ = parent->y_basis_status_;
+    child->x_basis_status_ = parent->x_basis_status_;
+    child->row_basis_status_ = parent->row_basis_status_;
+    child->parent_duals_ = parent->duals_;
+
     // 继承父节点的分支约束
     child->branched_var_ids_ = parent->branched_var_ids_;
     child->branched_bounds_ = parent->branched_bounds_;
 
     // 添加新的分支约束 (x <= floor)
     child->branched_var_ids_.push_back(parent->branch_var_id_);
+    ProtectBranchColumn(child, parent->branch_var_id_);
     child->branched_bounds_.push_back(parent->branch_floor_);
 
     LOG_FMT("[Branch] 创建左子节点 %d (var_%d <= %.0f)\n",
@@ -112,11 +130,18 @@ void CreateRightChild(BPNode* parent, int new_id, BPNode* child) {
     child->branch_dir_ = 2;  // 右分支
     child->sp1_method_ = parent->sp1_method_;
     child->sp2_method_ = parent->sp2_method_;
+    child->lower_bound_ = parent->lower_bound_;  // 子节点下界不低于父节点
 
     // 复制列集合
     child->y_columns_ = parent->y_columns_;
     child->x_columns_ = parent->x_columns_;
 
+    // 继承父节点最终主问题的基与对偶价格 (热启动)
+    child->y_basis_status_ = parent->y_basis_status_;
+    child->x_basis_status_ = parent->x_basis_status_;
+    child->row_basis_status_ = parent->row_basis_status_;
+    child->parent_duals_ = parent->duals_;
+
     // 继承父节点的分支约束
     child->branched_var_ids_ = parent->branched_var_ids_;
     child->branched_bounds_ = parent->branched_bounds_;
@@ -124,6 +149,7 @@ void CreateRightChild(BPNode* parent, int new_id, BPNode* child) {
     // 添加新的分支约束 (x >= ceil, 实现为将其他分支的变量设为0)
     // 简化处理: 右分支固定变量为ceil值
     child->branched_var_ids_.push_back(parent->branch_var_id_);
+    ProtectBranchColumn(child, parent->branch_var_id_);
     child->branched_bounds_.push_back(parent->branch_ceil_);
 
     LOG_FMT("[Branch] 创建右子节点 %d (var_%d >= %.0f)\n",
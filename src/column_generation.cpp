@@ -1,73 +1,583 @@
 // =============================================================================
-// column_generation.cpp - 列生成方法选择
+// column_generation.cpp - 列生成方法选择与多列提取
 // =============================================================================
 
 #include "2DBP.h"
 
 using namespace std;
 
-// 根节点SP1方法选择
-// 根据设置选择使用CPLEX/Arc Flow/DP求解SP1
-bool SolveRootSP1(ProblemParams& params, ProblemData& data, BPNode& node) {
-    int method = node.sp1_method_;
+static bool DispatchRootSP2(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id);
+static bool DispatchNodeSP2(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id);
+static bool TrySP2Shortcuts(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, bool& cg_converged);
+static void RecordSP2Result(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, int first_col);
 
-    switch (method) {
-        case kArcFlow:
-            return SolveRootSP1ArcFlow(params, data, node);
-        case kDP:
-            return SolveRootSP1DP(params, data, node);
-        case kCplexIP:
-        default:
-            return SolveRootSP1Knapsack(params, data, node);
+// 根节点SP1求解
+// 由定价引擎按设置选择CPLEX/Arc Flow/DP/分支定界求解 (无CPLEX构建时CPLEX类方法改用DP)
+// 启用全局列池时先扫描列池, 池中有改进列则不调用子问题
+bool SolveRootSP1(ProblemParams& params, ProblemData& data, BPNode& node) {
+    if (ScanPoolForYColumns(params, node) > 0) {
+        return false;
     }
+    params.column_pool_.oracle_calls_++;
+
+    return SolveRootSP1Exact(params, data, node);
 }
 
-// 根节点SP2方法选择
-// 根据设置选择使用CPLEX/Arc Flow/DP求解SP2
+// 根节点SP2求解
+// 由定价引擎按设置选择CPLEX/Arc Flow/DP/分支定界求解
+// 启用启发式定价时先贪心求解, 找到改进列则不调用精确方法 (收敛只由精确方法判定)
 bool SolveRootSP2(ProblemParams& params, ProblemData& data,
     BPNode& node, int strip_type_id) {
 
-    int method = node.sp2_method_;
+    if (ScanPoolForXColumns(params, node, strip_type_id) > 0) {
+        return false;
+    }
+    params.column_pool_.oracle_calls_++;
 
-    switch (method) {
-        case kArcFlow:
-            return SolveRootSP2ArcFlow(params, data, node, strip_type_id);
-        case kDP:
-            return SolveRootSP2DP(params, data, node, strip_type_id);
-        case kCplexIP:
-        default:
-            return SolveRootSP2Knapsack(params, data, node, strip_type_id);
+    return DispatchRootSP2(params, data, node, strip_type_id);
+}
+
+// SP2精确求解前的廉价步骤: 上界跳过、定价缓存与启发式
+// 返回: true=已得到结果 (cg_converged为结果), false=需要精确求解
+static bool TrySP2Shortcuts(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, bool& cg_converged) {
+
+    if (SkipSP2ByBound(params, data, node, strip_type_id)) {
+        cg_converged = true;
+        return true;
+    }
+    if (LookupPricingCache(params, data, node, strip_type_id, cg_converged)) {
+        return true;
+    }
+    if (PriceSP2Heuristic(params, data, node, strip_type_id) > 0) {
+        cg_converged = false;
+        return true;
     }
+    return false;
 }
 
-// 非根节点SP1方法选择
-bool SolveNodeSP1(ProblemParams& params, ProblemData& data, BPNode* node) {
-    int method = node->sp1_method_;
+// 记录SP2精确求解的结果, 供之后的上界跳过与定价缓存使用
+// first_col: 本次求解加入node.new_x_cols_的第一列
+static void RecordSP2Result(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, int first_col) {
+
+    RecordSP2Bound(params, data, node, strip_type_id);
+    StorePricingCache(params, data, node, strip_type_id, first_col);
+}
+
+// 根节点SP2求解 (不扫描列池, 并行定价任务直接调用)
+// 上界跳过、定价缓存与启发式都未得到结果时调用精确方法并记录结果
+static bool DispatchRootSP2(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id) {
+
+    bool cg_converged = true;
+    if (TrySP2Shortcuts(params, data, node, strip_type_id, cg_converged)) {
+        return cg_converged;
+    }
+
+    int first_col = static_cast<int>(node.new_x_cols_.size());
+    cg_converged = SolveRootSP2Exact(params, data, node, strip_type_id);
+    RecordSP2Result(params, data, node, strip_type_id, first_col);
+    return cg_converged;
+}
 
-    switch (method) {
-        case kArcFlow:
-            return SolveNodeSP1ArcFlow(params, data, node);
-        case kDP:
-            return SolveNodeSP1DP(params, data, node);
-        case kCplexIP:
-        default:
-            return SolveNodeSP1Knapsack(params, data, node);
+// 非根节点SP1求解
+bool SolveNodeSP1(ProblemParams& params, ProblemData& data, BPNode* node) {
+    if (ScanPoolForYColumns(params, *node) > 0) {
+        return false;
     }
+    params.column_pool_.oracle_calls_++;
+
+    return SolveNodeSP1Exact(params, data, node);
 }
 
-// 非根节点SP2方法选择
+// 非根节点SP2求解
 bool SolveNodeSP2(ProblemParams& params, ProblemData& data,
     BPNode* node, int strip_type_id) {
 
-    int method = node->sp2_method_;
+    if (ScanPoolForXColumns(params, *node, strip_type_id) > 0) {
+        return false;
+    }
+    params.column_pool_.oracle_calls_++;
+
+    return DispatchNodeSP2(params, data, node, strip_type_id);
+}
+
+// 非根节点SP2求解 (不扫描列池, 并行定价任务直接调用)
+// 上界跳过、定价缓存与启发式都未得到结果时调用精确方法并记录结果
+static bool DispatchNodeSP2(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id) {
+
+    bool cg_converged = true;
+    if (TrySP2Shortcuts(params, data, *node, strip_type_id, cg_converged)) {
+        return cg_converged;
+    }
+
+    int first_col = static_cast<int>(node->new_x_cols_.size());
+    cg_converged = SolveNodeSP2Exact(params, data, node, strip_type_id);
+    RecordSP2Result(params, data, *node, strip_type_id, first_col);
+    return cg_converged;
+}
+
+// 求解全部SP2 (条带类型之间相互独立, 在定价线程池上并行)
+// 1. 串行扫描列池: 列池中有改进列的条带类型不调用子问题
+// 2. 其余条带类型各自在影子节点 (只含对偶价格与迭代信息) 上求解,
+//    使用所在线程的工作区, 日志写入任务缓冲区
+// 3. 按条带类型顺序合并改进列, SP2上界与日志, 结果与线程数和调度无关
+// 返回: true=所有SP2均无改进列
+static bool PriceAllSP2(ProblemParams& params, ProblemData& data,
+    BPNode& node, bool is_root) {
+
+    int num_strip_types = params.num_strip_types_;
+    node.sp2_bounds_.assign(num_strip_types, INFINITY);
+
+    vector<vector<XColumn>> pool_cols(num_strip_types);
+    vector<int> task_strip_ids;
+    for (int j = 0; j < num_strip_types; j++) {
+        size_t begin = node.new_x_cols_.size();
+        if (ScanPoolForXColumns(params, node, j) > 0) {
+            pool_cols[j].assign(make_move_iterator(node.new_x_cols_.begin() + begin),
+                make_move_iterator(node.new_x_cols_.end()));
+            node.new_x_cols_.resize(begin);
+        } else {
+            params.column_pool_.oracle_calls_++;
+            task_strip_ids.push_back(j);
+        }
+    }
+
+    // Arc网络按需生成会修改data, 须在并行前完成
+    if (node.sp2_method_ == kArcFlow) {
+        for (int j = (int)data.sp2_arc_data_.size(); j < num_strip_types; j++) {
+            GenerateSP2Arcs(data, params, j);
+        }
+    }
+#ifndef CS_NO_CPLEX
+    // 常驻子问题模型的槽位同样须在并行前分配 (各任务只建立自己条带类型的模型)
+    PrepareSP2Models(params, data);
+#endif
+
+    // 嵌套DP模式: 并行任务只做廉价步骤, 其余条带类型之后一次扫描求解
+    bool nested = params.nested_sp2_dp_ && node.sp2_method_ == kDP;
+
+    int num_tasks = static_cast<int>(task_strip_ids.size());
+    vector<BPNode> task_nodes(num_tasks);
+    vector<string> task_logs(num_tasks);
+    vector<int> task_converged(num_tasks, 1);
+    vector<int> task_solved(num_tasks, 1);
+    RunPricingTasks(num_tasks, [&](int t) {
+        int j = task_strip_ids[t];
+        BPNode& task_node = task_nodes[t];
+        task_node.id_ = node.id_;
+        task_node.iter_ = node.iter_;
+        task_node.sp2_method_ = node.sp2_method_;
+        task_node.duals_ = node.duals_;
+        task_node.sp2_bounds_.assign(num_strip_types, INFINITY);
+
+        ostringstream log_buf;
+        log_redirect_stream = &log_buf;
+        bool converged = true;
+        if (nested) {
+            task_solved[t] = TrySP2Shortcuts(params, data, task_node, j, converged) ? 1 : 0;
+        } else if (is_root) {
+            converged = DispatchRootSP2(params, data, task_node, j);
+        } else {
+            converged = DispatchNodeSP2(params, data, &task_node, j);
+        }
+        log_redirect_stream = nullptr;
+
+        task_converged[t] = converged ? 1 : 0;
+        task_logs[t] = log_buf.str();
+    });
+
+    if (nested) {
+        vector<int> exact_tasks;
+        vector<int> exact_strip_ids;
+        for (int t = 0; t < num_tasks; t++) {
+            if (!task_solved[t]) {
+                exact_tasks.push_back(t);
+                exact_strip_ids.push_back(task_strip_ids[t]);
+            }
+        }
+
+        vector<vector<vector<int>>> patterns;
+        SolveNestedSP2DP(params, data, node, exact_strip_ids, patterns);
+        for (int e = 0; e < (int)exact_tasks.size(); e++) {
+            int t = exact_tasks[e];
+            int j = task_strip_ids[t];
+            BPNode& task_node = task_nodes[t];
+            task_node.sp2_bounds_[j] = node.sp2_bounds_[j];
+            for (auto& pattern : patterns[e]) {
+                XColumn x_col;
+                x_col.strip_type_id_ = j;
+                x_col.pattern_ = pattern;
+                task_node.new_x_cols_.push_back(x_col);
+            }
+            task_converged[t] = patterns[e].empty() ? 1 : 0;
+            RecordSP2Result(params, data, task_node, j, 0);
+        }
+    }
+
+    bool all_converged = true;
+    int t = 0;
+    for (int j = 0; j < num_strip_types; j++) {
+        vector<XColumn>* cols = &pool_cols[j];
+        if (t < num_tasks && task_strip_ids[t] == j) {
+            LOG_NO_NL(task_logs[t]);
+            node.sp2_bounds_[j] = task_nodes[t].sp2_bounds_[j];
+            cols = &task_nodes[t].new_x_cols_;
+            if (!task_converged[t]) {
+                all_converged = false;
+            }
+            t++;
+        } else {
+            all_converged = false;
+        }
+        for (XColumn& x_col : *cols) {
+            node.new_x_cols_.push_back(move(x_col));
+        }
+    }
+
+    return all_converged;
+}
+
+// 联合定价的SP1: 条带类型j的价值取 max(pi_j, v_j), v_j为本轮SP2改进列的最大价值 sum(mu_i * b_i)
+// v_j > pi_j的条带由本轮的X列切割, 整板方案 (Y列及其各条带的X列) 的检验数为
+//   1 - sum(a_j * max(pi_j, v_j))
+// SP1最优值大于1时新Y列与同轮X列共同构成改进的整板方案 (Y列自身在pi下未必改进);
+// 所有SP2均收敛时条带价值即pi_j, 与普通SP1相同, 因此收敛判断不变
+// 返回: true=SP1无改进列
+static bool SolveJointSP1(ProblemParams& params, ProblemData& data,
+    BPNode& node, bool is_root) {
+
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
+
+    vector<double> joint_duals = node.duals_;
+    for (const XColumn& x_col : node.new_x_cols_) {
+        double val = 0;
+        for (int i = 0; i < num_item_types; i++) {
+            val += x_col.pattern_[i] * node.duals_[num_strip_types + i];
+        }
+        int j = x_col.strip_type_id_;
+        joint_duals[j] = max(joint_duals[j], val);
+    }
+
+    int num_raised = 0;
+    for (int j = 0; j < num_strip_types; j++) {
+        if (joint_duals[j] > node.duals_[j]) {
+            num_raised++;
+        }
+    }
+    if (num_raised > 0) {
+        LOG_FMT("[SP1-%d] 联合定价: %d个条带类型按SP2最优值计价\n", node.iter_, num_raised);
+    }
+
+    // SP1各求解方法均从node.duals_读取条带价值, 求解期间临时替换
+    swap(node.duals_, joint_duals);
+    bool converged = is_root
+        ? SolveRootSP1(params, data, node)
+        : SolveNodeSP1(params, data, &node);
+    swap(node.duals_, joint_duals);
+
+    return converged;
+}
+
+// 用当前node.duals_求解SP1与全部SP2, 改进列存入node.new_*_cols_
+// 返回: true=所有子问题均无改进列
+static bool PriceAllSubproblems(ProblemParams& params, ProblemData& data,
+    BPNode& node, bool is_root) {
+
+    bool sp1_converged = true;
+    bool all_sp2_converged = true;
+    if (params.pricing_mode_ == kJointPricing) {
+        // 联合定价: 先求全部SP2, 再按条带的SP2最优值求SP1
+        all_sp2_converged = PriceAllSP2(params, data, node, is_root);
+        sp1_converged = SolveJointSP1(params, data, node, is_root);
+    } else {
+        sp1_converged = is_root
+            ? SolveRootSP1(params, data, node)
+            : SolveNodeSP1(params, data, &node);
+        all_sp2_converged = PriceAllSP2(params, data, node, is_root);
+    }
+
+    // 本轮定价对偶价格对应的拉格朗日下界 (任意非负对偶价格均有效, 取最好值)
+    double bound = ComputeLagrangianBound(params, data, node);
+    if (bound > node.lagrangian_bound_) {
+        node.lagrangian_bound_ = bound;
+    }
+
+    return sp1_converged && all_sp2_converged;
+}
+
+// 批量定价轮次
+// SP1与全部SP2使用同一组对偶价格求解, 本轮所有改进列一次性加入主问题
+// 启用对偶稳定化时先用稳定化对偶价格定价; 若发生误定价则用主问题对偶价格重新定价,
+// 因此收敛判断始终基于主问题对偶价格
+// 返回: true=列生成收敛, false=找到改进列
+bool SolvePricingRound(ProblemParams& params, ProblemData& data,
+    BPNode& node, bool is_root) {
+
+    bool stabilized = StabilizeDuals(params, node);
+    bool converged = PriceAllSubproblems(params, data, node, is_root);
+
+    if (stabilized && DetectMispricing(params, node)) {
+        converged = PriceAllSubproblems(params, data, node, is_root);
+    } else if (stabilized) {
+        converged = false;
+    }
+
+    return converged;
+}
+
+// 拉格朗日 (Farley) 下界
+// 对定价对偶价格(pi, mu), 令 pi'_j = max(pi_j, v2_j), v2_j为SP2最优值的上界,
+// 则所有X列在(pi', mu)下检验数非负; 再以 s = max(1, SP1(pi')) 缩放, Y列检验数也非负,
+// 得到可行的拉格朗日乘子 (pi', mu) / s, 下界为:
+//   LB = sum(d_i * mu_i) / s
+// 非根节点的分支约束只是变量上界, 去掉上界后的松弛下界对节点依然有效
+// 返回: 下界值, -INFINITY表示本轮SP2未全部精确求解
+double ComputeLagrangianBound(ProblemParams& params, ProblemData& data, BPNode& node) {
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
+
+    if ((int)node.sp2_bounds_.size() != num_strip_types) {
+        return -INFINITY;
+    }
+
+    vector<double> strip_profits(num_strip_types);
+    for (int j = 0; j < num_strip_types; j++) {
+        if (node.sp2_bounds_[j] == INFINITY) {
+            return -INFINITY;
+        }
+        strip_profits[j] = max(node.duals_[j], node.sp2_bounds_[j]);
+    }
+
+    // SP1(pi'): 按SP1的求解方法求解; 只用到max(1, SP1(pi')), 阈值取1,
+    // 不超过1时求解方法只需证明这一点, 任意上界都给出有效的缩放
+    double scale = max(1.0, SolveSP1Value(params, data, node, strip_profits, 1.0));
+
+    double bound = 0;
+    for (int i = 0; i < num_item_types; i++) {
+        bound += data.item_types_[i].demand_ * node.duals_[num_strip_types + i];
+    }
+    bound /= scale;
+
+    return bound;
+}
+
+// 根据拉格朗日下界判断是否提前终止列生成
+// 目标值 (母板数) 为整数, 因此:
+//   ceil(LB) >= ceil(z_MP): 继续迭代不会改变取整后的节点下界
+//   ceil(LB) >= 当前最优整数解: 节点不可能改进最优解, 剪枝
+// 返回: 0=继续, 1=下界间隙已闭合, 2=节点被下界剪枝
+int CheckLagrangianTermination(ProblemParams& params, BPNode& node) {
+    if (node.lagrangian_bound_ == -INFINITY) {
+        return 0;
+    }
+
+    double lb_ceil = ceil(node.lagrangian_bound_ - kRcTolerance);
+    double mp_ceil = ceil(node.mp_obj_val_ - kRcTolerance);
+
+    LOG_FMT("[CG] 拉格朗日下界: %.4f (主问题目标值 %.4f)\n",
+        node.lagrangian_bound_, node.mp_obj_val_);
+
+    if (lb_ceil >= params.global_best_int_ - kZeroTolerance) {
+        LOG_FMT("[CG] 节点%d 下界%.0f达到最优整数解%.0f, 提前剪枝\n",
+            node.id_, lb_ceil, params.global_best_int_);
+        return 2;
+    }
+
+    if (lb_ceil >= mp_ceil) {
+        LOG_FMT("[CG] 下界取整与主问题目标值取整相同 (%.0f), 提前终止\n", lb_ceil);
+        return 1;
+    }
+
+    return 0;
+}
 
-    switch (method) {
-        case kArcFlow:
-            return SolveNodeSP2ArcFlow(params, data, node, strip_type_id);
-        case kDP:
-            return SolveNodeSP2DP(params, data, node, strip_type_id);
-        case kCplexIP:
-        default:
-            return SolveNodeSP2Knapsack(params, data, node, strip_type_id);
+// 列生成结束后更新节点下界 (最终主问题求解之后调用)
+// 收敛时主问题目标值即LP松弛最优值; 提前终止 (拉格朗日下界或迭代上限) 时
+// 受限主问题的目标值只是LP松弛的上界, 下界取拉格朗日下界与已有下界 (继承自父节点) 的较大者
+// 逐个定价模式下各SP2求解之间对偶价格会变化, 不计算拉格朗日下界; 此时 (及尚未得到拉格朗日下界时)
+// 仍按原规则取主问题目标值
+void UpdateNodeLowerBound(ProblemParams& params, BPNode& node, bool cg_converged) {
+    if (cg_converged || params.pricing_mode_ == kSequentialPricing ||
+        node.lagrangian_bound_ == -INFINITY) {
+        node.lower_bound_ = node.solution_.obj_val_;
+        return;
     }
+
+    node.lower_bound_ = max(node.lower_bound_, node.lagrangian_bound_);
+    LOG_FMT("[CG] 列生成未收敛, 节点下界 %.4f (主问题目标值 %.4f)\n",
+        node.lower_bound_, node.solution_.obj_val_);
+}
+
+#ifndef CS_NO_CPLEX
+// 求解定价子问题的CPLEX模型
+// 每次只取1列时直接solve; 取多列时用populate填充解池
+// 未启用常驻模型时每次新建模型, 只取最优解 (一列), 线程数保持CPLEX默认
+bool SolveSPModel(ProblemParams& params, IloCplex& cplex) {
+    if (!params.resident_sp_models_) {
+        return cplex.solve();
+    }
+
+    int max_cols = params.max_cols_per_sp_;
+
+    // 并行定价时各子问题单线程求解, 避免与定价线程池争抢核心
+    if (GetNumPricingThreads() > 1) {
+        cplex.setParam(IloCplex::Threads, 1);
+    }
+
+    if (max_cols <= 1) {
+        return cplex.solve();
+    }
+
+    // 常驻模型的解池保留着上一组对偶价格下的解, 先清空
+    if (cplex.getSolnPoolNsolns() > 0) {
+        cplex.delSolnPoolSolns(0, cplex.getSolnPoolNsolns() - 1);
+    }
+
+    // 同一方案可能对应多个Arc组合, 解池容量留出余量供去重
+    cplex.setParam(IloCplex::SolnPoolCapacity, 4 * max_cols);
+    cplex.setParam(IloCplex::PopulateLim, 4 * max_cols);
+    cplex.setParam(IloCplex::SolnPoolReplace, 1);  // 替换目标值最差的解
+    return cplex.populate();
+}
+
+// 收集解池中目标值大于阈值的解编号 (按目标值降序)
+// 单列模式只返回最优解 (编号-1, 即incumbent)
+vector<int> CollectImprovingSolutions(ProblemParams& params, IloCplex& cplex,
+    double threshold) {
+
+    vector<int> solns;
+
+    if (!params.resident_sp_models_ || params.max_cols_per_sp_ <= 1) {
+        if (cplex.getObjValue() > threshold) {
+            solns.push_back(-1);
+        }
+        return solns;
+    }
+
+    vector<pair<double, int>> ranked;
+    int num_solns = static_cast<int>(cplex.getSolnPoolNsolns());
+    for (int s = 0; s < num_solns; s++) {
+        double obj_val = cplex.getObjValue(s);
+        if (obj_val > threshold) {
+            ranked.push_back({obj_val, s});
+        }
+    }
+
+    stable_sort(ranked.begin(), ranked.end(),
+        [](const pair<double, int>& a, const pair<double, int>& b) {
+            return a.first > b.first;
+        });
+
+    for (auto& r : ranked) {
+        solns.push_back(r.second);
+    }
+    return solns;
+}
+#endif
+
+// 条带中子件i的数量上界: 需求量 (超出需求的子件可从任意整数解中去掉)
+// 返回: INT_MAX表示不限 (未启用需求上界)
+int ItemCountBound(ProblemParams& params, ProblemData& data, int item_type_id) {
+    if (!params.demand_bounded_) {
+        return INT_MAX;
+    }
+    return data.item_types_[item_type_id].demand_;
+}
+
+// 母板中条带类型j的数量上界: 可放入该条带的子件 (宽度不超过条带宽度) 的需求之和
+// 有用的条带至少包含一个子件, 多余的条带可从任意整数解中去掉
+int StripCountBound(ProblemParams& params, ProblemData& data, int strip_type_id) {
+    if (!params.demand_bounded_) {
+        return INT_MAX;
+    }
+
+    int strip_width = data.strip_types_[strip_type_id].width_;
+    int bound = 0;
+    for (const ItemType& item : data.item_types_) {
+        if (item.width_ <= strip_width) {
+            bound += item.demand_;
+        }
+    }
+    return bound;
+}
+
+#ifndef CS_NO_CPLEX
+// Arc Flow子问题的数量上界约束: 同一物品对应的非损耗Arc选取数不超过上界
+// arc_types[a]: 变量a (Arc上的一种物品, 即ArcFlowGraph::arc_items_) 放置的物品 (-1=损耗弧),
+// bounds[t]: 物品t的上界,
+// max_counts[t]: 容量内最多可放入的件数 (上界不小于该值时约束不起作用, 不加入模型)
+static void AddArcCountBounds(IloModel& model, IloNumVarArray& vars,
+    const vector<int>& arc_types, const vector<int>& bounds,
+    const vector<int>& max_counts) {
+
+    IloEnv env = model.getEnv();
+    int num_types = static_cast<int>(bounds.size());
+    vector<vector<int>> type_arcs(num_types);
+    for (int a = 0; a < (int)arc_types.size(); a++) {
+        if (arc_types[a] >= 0) {
+            type_arcs[arc_types[a]].push_back(a);
+        }
+    }
+
+    for (int t = 0; t < num_types; t++) {
+        if (bounds[t] >= max_counts[t] || type_arcs[t].empty()) continue;
+
+        IloExpr count_expr(env);
+        for (int a : type_arcs[t]) {
+            count_expr += vars[a];
+        }
+        model.add(count_expr <= bounds[t]);
+        count_expr.end();
+    }
+}
+
+// SP1 Arc Flow: 各条带类型的Arc数不超过StripCountBound
+void AddSP1ArcCountBounds(ProblemParams& params, ProblemData& data,
+    IloModel& model, IloNumVarArray& vars) {
+
+    if (!params.demand_bounded_) {
+        return;
+    }
+
+    int num_strip_types = params.num_strip_types_;
+    const vector<int>& arc_types = data.sp1_arc_data_.arc_items_;
+
+    vector<int> bounds(num_strip_types);
+    vector<int> max_counts(num_strip_types);
+    for (int j = 0; j < num_strip_types; j++) {
+        bounds[j] = StripCountBound(params, data, j);
+        max_counts[j] = params.stock_width_ / data.strip_types_[j].width_;
+    }
+
+    AddArcCountBounds(model, vars, arc_types, bounds, max_counts);
+}
+
+// SP2 Arc Flow: 各子件的Arc数不超过ItemCountBound
+void AddSP2ArcCountBounds(ProblemParams& params, ProblemData& data,
+    int strip_type_id, IloModel& model, IloNumVarArray& vars) {
+
+    if (!params.demand_bounded_) {
+        return;
+    }
+
+    int num_item_types = params.num_item_types_;
+    const vector<int>& arc_types = data.sp2_arc_data_[strip_type_id].arc_items_;
+
+    vector<int> bounds(num_item_types);
+    vector<int> max_counts(num_item_types);
+    for (int i = 0; i < num_item_types; i++) {
+        bounds[i] = ItemCountBound(params, data, i);
+        max_counts[i] = params.stock_length_ / data.item_types_[i].length_;
+    }
+
+    AddArcCountBounds(model, vars, arc_types, bounds, max_counts);
 }
+#endif
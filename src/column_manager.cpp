@@ -0,0 +1,126 @@
+// =============================================================================
+// column_manager.cpp - 列老化与清除 (控制限制主问题规模)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 判断列是否受保护 (初始列, 或被本节点分支约束引用的列)
+static bool IsProtectedColumn(BPNode& node, int var_idx, int protect_flag) {
+    if (protect_flag == 1) {
+        return true;
+    }
+    for (int id : node.branched_var_ids_) {
+        if (id == var_idx) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 更新列年龄
+// 列在LP解中取0且检验数为正 (非基变量) 时年龄+1, 否则清零
+static void UpdateColumnAges(MasterLP& mp, BPNode& node) {
+    int num_y_cols = static_cast<int>(node.y_columns_.size());
+    int num_x_cols = static_cast<int>(node.x_columns_.size());
+
+    for (int col = 0; col < num_y_cols; col++) {
+        if (mp.y_values_[col] <= kZeroTolerance && mp.y_rcs_[col] > kRcTolerance) {
+            node.y_columns_[col].age_++;
+        } else {
+            node.y_columns_[col].age_ = 0;
+        }
+    }
+
+    for (int col = 0; col < num_x_cols; col++) {
+        if (mp.x_values_[col] <= kZeroTolerance && mp.x_rcs_[col] > kRcTolerance) {
+            node.x_columns_[col].age_++;
+        } else {
+            node.x_columns_[col].age_ = 0;
+        }
+    }
+}
+
+// 列管理: 更新年龄并清除过期列
+// 仅清除非基变量, 当前最优基不受影响, 下次求解仍可热启动
+// 清除后重映射branched_var_ids_ (Y列在前, X列在后的统一编号)
+// 返回清除的列数
+int ManageColumns(ProblemParams& params, MasterLP& mp, BPNode& node) {
+    if (params.column_max_age_ <= 0) {
+        return 0;
+    }
+
+    UpdateColumnAges(mp, node);
+
+    int num_y_cols = static_cast<int>(node.y_columns_.size());
+    int num_x_cols = static_cast<int>(node.x_columns_.size());
+
+    // 标记过期列: 年龄达到上限且不受保护
+    vector<int> y_flags(num_y_cols, 0);
+    vector<int> x_flags(num_x_cols, 0);
+    int num_purged_y = 0;
+    int num_purged_x = 0;
+    for (int col = 0; col < num_y_cols; col++) {
+        YColumn& y_col = node.y_columns_[col];
+        if (y_col.age_ >= params.column_max_age_ &&
+            !IsProtectedColumn(node, col, y_col.protect_flag_)) {
+            y_flags[col] = 1;
+            num_purged_y++;
+        }
+    }
+    for (int col = 0; col < num_x_cols; col++) {
+        XColumn& x_col = node.x_columns_[col];
+        if (x_col.age_ >= params.column_max_age_ &&
+            !IsProtectedColumn(node, num_y_cols + col, x_col.protect_flag_)) {
+            x_flags[col] = 1;
+            num_purged_x++;
+        }
+    }
+
+    if (num_purged_y + num_purged_x == 0) {
+        return 0;
+    }
+
+    // 求解器拒绝删除的列 (基变量) 标志已清零, 按实际删除的列计数
+    RemoveColumnsFromMP(mp, y_flags, x_flags);
+    num_purged_y = static_cast<int>(count(y_flags.begin(), y_flags.end(), 1));
+    num_purged_x = static_cast<int>(count(x_flags.begin(), x_flags.end(), 1));
+    int num_purged = num_purged_y + num_purged_x;
+    if (num_purged == 0) {
+        return 0;
+    }
+
+    // 同步节点列集合, 记录旧编号 -> 新编号
+    vector<int> new_index(num_y_cols + num_x_cols, -1);
+    vector<YColumn> kept_y_cols;
+    vector<XColumn> kept_x_cols;
+    int num_kept_y = num_y_cols - num_purged_y;
+    for (int col = 0; col < num_y_cols; col++) {
+        if (y_flags[col] == 0) {
+            new_index[col] = static_cast<int>(kept_y_cols.size());
+            kept_y_cols.push_back(node.y_columns_[col]);
+        }
+    }
+    for (int col = 0; col < num_x_cols; col++) {
+        if (x_flags[col] == 0) {
+            new_index[num_y_cols + col] = num_kept_y + static_cast<int>(kept_x_cols.size());
+            kept_x_cols.push_back(node.x_columns_[col]);
+        }
+    }
+
+    // 分支列均受保护, 重映射后不会出现-1
+    for (int& id : node.branched_var_ids_) {
+        id = new_index[id];
+    }
+
+    node.y_columns_ = move(kept_y_cols);
+    node.x_columns_ = move(kept_x_cols);
+    params.num_purged_cols_ += num_purged;
+
+    LOG_FMT("[Column] 清除过期列 Y=%d, X=%d (剩余 Y=%d, X=%d)\n",
+        num_purged_y, num_purged_x,
+        (int)node.y_columns_.size(), (int)node.x_columns_.size());
+
+    return num_purged;
+}
@@ -0,0 +1,144 @@
+// =============================================================================
+// column_pool.cpp - 全局列池 (跨分支定价节点共享已生成的列)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 将Y列加入全局列池 (方案已存在时忽略)
+void AddYColumnToPool(ProblemParams& params, const YColumn& y_col) {
+    ColumnPool& pool = params.column_pool_;
+    if (pool.y_keys_.insert(y_col.pattern_).second) {
+        YColumn pool_col;
+        pool_col.pattern_ = y_col.pattern_;
+        pool_col.arc_set_ = y_col.arc_set_;
+        pool.y_cols_.push_back(pool_col);
+    }
+}
+
+// 将X列加入全局列池 (条带类型与方案均相同时忽略)
+void AddXColumnToPool(ProblemParams& params, const XColumn& x_col) {
+    ColumnPool& pool = params.column_pool_;
+    if (pool.x_keys_.insert({x_col.strip_type_id_, x_col.pattern_}).second) {
+        XColumn pool_col;
+        pool_col.strip_type_id_ = x_col.strip_type_id_;
+        pool_col.pattern_ = x_col.pattern_;
+        pool_col.arc_set_ = x_col.arc_set_;
+        pool.x_cols_.push_back(pool_col);
+    }
+}
+
+// 在列池中查找当前对偶价格下的改进Y列
+// Y列检验数: 1 - sum(pi_j * a_j) < 0
+// 已在节点列集合中的列不再加入 (被分支约束限制上界的列会有负检验数,
+// 重复加入相当于绕过分支约束)
+// 返回: 加入node.new_y_cols_的列数, 最多max_cols_per_sp_列
+int ScanPoolForYColumns(ProblemParams& params, BPNode& node) {
+    if (!params.use_column_pool_) {
+        return 0;
+    }
+
+    ColumnPool& pool = params.column_pool_;
+    int num_strip_types = params.num_strip_types_;
+
+    // (检验数, 池中编号)
+    vector<pair<double, int>> candidates;
+    for (int k = 0; k < (int)pool.y_cols_.size(); k++) {
+        const vector<int>& pattern = pool.y_cols_[k].pattern_;
+        double rc = 1.0;
+        for (int j = 0; j < num_strip_types; j++) {
+            rc -= node.duals_[j] * pattern[j];
+        }
+        if (rc < -kRcTolerance) {
+            candidates.push_back({rc, k});
+        }
+    }
+    sort(candidates.begin(), candidates.end());
+
+    int num_added = 0;
+    for (auto& [rc, k] : candidates) {
+        if (num_added >= params.max_cols_per_sp_) break;
+
+        const YColumn& pool_col = pool.y_cols_[k];
+        bool in_node = false;
+        for (const YColumn& y_col : node.y_columns_) {
+            if (y_col.pattern_ == pool_col.pattern_) {
+                in_node = true;
+                break;
+            }
+        }
+        if (in_node) continue;
+
+        YColumn new_col;
+        new_col.pattern_ = pool_col.pattern_;
+        new_col.arc_set_ = pool_col.arc_set_;
+        node.new_y_cols_.push_back(new_col);
+        num_added++;
+    }
+
+    if (num_added > 0) {
+        pool.saved_calls_++;
+        LOG_FMT("[Pool] 从列池取得%d个Y列, 跳过SP1\n", num_added);
+    }
+
+    return num_added;
+}
+
+// 在列池中查找当前对偶价格下条带类型strip_type_id的改进X列
+// X列检验数: pi_j - sum(mu_i * b_i) < 0
+// 返回: 加入node.new_x_cols_的列数, 最多max_cols_per_sp_列
+int ScanPoolForXColumns(ProblemParams& params, BPNode& node, int strip_type_id) {
+    if (!params.use_column_pool_) {
+        return 0;
+    }
+
+    ColumnPool& pool = params.column_pool_;
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
+
+    vector<pair<double, int>> candidates;
+    for (int k = 0; k < (int)pool.x_cols_.size(); k++) {
+        if (pool.x_cols_[k].strip_type_id_ != strip_type_id) continue;
+
+        const vector<int>& pattern = pool.x_cols_[k].pattern_;
+        double rc = node.duals_[strip_type_id];
+        for (int i = 0; i < num_item_types; i++) {
+            rc -= node.duals_[num_strip_types + i] * pattern[i];
+        }
+        if (rc < -kRcTolerance) {
+            candidates.push_back({rc, k});
+        }
+    }
+    sort(candidates.begin(), candidates.end());
+
+    int num_added = 0;
+    for (auto& [rc, k] : candidates) {
+        if (num_added >= params.max_cols_per_sp_) break;
+
+        const XColumn& pool_col = pool.x_cols_[k];
+        bool in_node = false;
+        for (const XColumn& x_col : node.x_columns_) {
+            if (x_col.strip_type_id_ == strip_type_id &&
+                x_col.pattern_ == pool_col.pattern_) {
+                in_node = true;
+                break;
+            }
+        }
+        if (in_node) continue;
+
+        XColumn new_col;
+        new_col.strip_type_id_ = strip_type_id;
+        new_col.pattern_ = pool_col.pattern_;
+        new_col.arc_set_ = pool_col.arc_set_;
+        node.new_x_cols_.push_back(new_col);
+        num_added++;
+    }
+
+    if (num_added > 0) {
+        pool.saved_calls_++;
+        LOG_FMT("[Pool] 从列池取得%d个X列, 跳过SP2-%d\n", num_added, strip_type_id + 1);
+    }
+
+    return num_added;
+}
@@ -0,0 +1,484 @@
+// =============================================================================
+// knapsack.cpp - 完全背包DP内核 (SP1/SP2的DP求解共用)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 按物品数重置工作区的尺寸与价值 (保留已分配的内存)
+void PrepareKnapsackDP(KnapsackDP& kp, int num_items) {
+    kp.sizes_.assign(num_items, 0);
+    kp.values_.assign(num_items, 0.0);
+    kp.bounds_.assign(num_items, INT_MAX);
+}
+
+// 物品是否参与DP (价值为正且尺寸落在可达位置网格上)
+static bool IsActiveItem(const KnapsackDP& kp, const RasterPoints& raster, int i) {
+    int size = kp.sizes_[i];
+    return kp.values_[i] > 0 && size > 0 && size <= raster.capacity_ &&
+        size % raster.gcd_ == 0 && kp.bounds_[i] > 0;
+}
+
+// 物品的数量上限是否起作用 (容量内可放入的件数超过上限)
+static bool IsBoundedItem(const KnapsackDP& kp, const RasterPoints& raster, int i) {
+    return kp.bounds_[i] < raster.capacity_ / kp.sizes_[i];
+}
+
+// 方案是否满足各物品的数量上限
+static bool WithinBounds(const KnapsackDP& kp, const vector<int>& pattern) {
+    for (int i = 0; i < (int)pattern.size(); i++) {
+        if (pattern[i] > kp.bounds_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 定点内核参数
+constexpr int32_t kFixedValueBudget = 1 << 30;      // 定点价值上限 (不可达极小值加价值不溢出)
+constexpr int32_t kFixedUnreachable = INT32_MIN;    // 不可达位置的定点价值
+constexpr int kDenseGridRatio = 8;                  // 稠密网格不超过可达位置数的该倍数时用定点内核
+constexpr int kDenseExactRatio = 2;                 // 稠密网格不超过可达位置数的该倍数时双精度DP在网格上展开
+
+// 对dp_取前缀最大值, 得到"占用不超过该位置"的最优价值, 并记录实际占用的位置
+static void FinishKnapsackDP(KnapsackDP& kp) {
+    double* dp = kp.dp_.data();
+    int num_points = static_cast<int>(kp.dp_.size());
+    kp.best_point_.resize(num_points);
+    for (int k = 0; k < num_points; k++) {
+        kp.best_point_[k] = k;
+        if (k > 0 && dp[k - 1] >= dp[k]) {
+            dp[k] = dp[k - 1];
+            kp.best_point_[k] = kp.best_point_[k - 1];
+        }
+    }
+}
+
+// 在dp上展开阶段p (piece_items_[p]的piece_counts_[p]件, 件数0为不限数量):
+// 不限数量时源位置升序松弛 (完全背包), 否则源位置降序松弛 (0-1物品, 读到的源位置价值均为上一阶段的值);
+// 严格改进的位置记录last_piece[k] = p, 即最后一次改进该位置的阶段
+static void RelaxPiece(const KnapsackDP& kp, int p, double* dp, int* last_piece) {
+    const RasterPoints& raster = *kp.raster_;
+    int num_points = static_cast<int>(raster.points_.size());
+    const int* points = raster.points_.data();
+    int capacity = raster.capacity_;
+
+    int i = kp.piece_items_[p];
+    int count = kp.piece_counts_[p];
+    int size = kp.sizes_[i] * max(1, count);
+    double val = kp.values_[i] * max(1, count);
+    if (count == 0) {
+        int next = 0;
+        for (int k = 0; k < num_points; k++) {
+            if (points[k] + size > capacity) break;
+
+            while (points[next] < points[k] + size) next++;
+            double cand = dp[k] + val;
+            if (cand > dp[next]) {
+                dp[next] = cand;
+                last_piece[next] = p;
+            }
+        }
+    } else {
+        int next = num_points - 1;
+        for (int k = FindFloorPoint(raster, capacity - size); k >= 0; k--) {
+            while (points[next] > points[k] + size) next--;
+            double cand = dp[k] + val;
+            if (cand > dp[next]) {
+                dp[next] = cand;
+                last_piece[next] = p;
+            }
+        }
+    }
+}
+
+// 双精度DP: 只在可达位置上展开
+// 可达位置加任一尺寸仍可达 (不超过容量时), 按位置升序松弛即为完全背包
+// 只在严格改进时更新, 因此last_item_[k]指向的前驱位置在之后不会再变化
+// (前驱价值若再提高, 该位置价值必然随之严格提高并改写指针), 回溯结果与价值一致
+// 有数量上限的物品在完全背包阶段之后按二进制拆分 (1, 2, 4, ..., 余数) 作为0-1物品展开:
+// 每个位置只记录最后一次改进它的0-1物品 (last_piece_), 并保存0-1阶段开始前的dp (piece_base_dp_), 内存O(|P|)
+// 可达位置足够稠密时, 完全背包阶段改在按gcd缩放的稠密网格上按下标差直接松弛 (与原逐格循环相同):
+// 网格全部初始化为0, 即"占用不超过该格点"的最优价值, 映射回可达位置后与逐位置展开取前缀最大值的结果一致;
+// 前驱格点未必可达, 回溯指针留在网格上 (fixed_last_), 回溯也在网格上进行
+static double SolveKnapsackExact(KnapsackDP& kp, const RasterPoints& raster) {
+    int num_points = static_cast<int>(raster.points_.size());
+    int gcd_val = raster.gcd_;
+    long long num_cells = raster.capacity_ / gcd_val + 1LL;
+    bool use_grid = num_cells <= kDenseExactRatio * static_cast<long long>(num_points);
+
+    // 可达位置即全部格点时网格就是dp_本身
+    kp.grid_last_ = use_grid && num_cells != num_points;
+    kp.dp_.assign(num_points, 0.0);
+    kp.last_item_.assign(num_points, -1);
+    kp.piece_items_.clear();
+    kp.piece_counts_.clear();
+    kp.dp_error_ = 0.0;
+
+    double* dp = kp.dp_.data();
+    int* last_item = kp.last_item_.data();
+    const int* points = raster.points_.data();
+    int capacity = raster.capacity_;
+
+    double* grid = dp;
+    int* grid_last = last_item;
+    if (kp.grid_last_) {
+        kp.grid_dp_.assign(num_cells, 0.0);
+        kp.fixed_last_.assign(num_cells, -1);
+        grid = kp.grid_dp_.data();
+        grid_last = kp.fixed_last_.data();
+    }
+
+    int num_items = static_cast<int>(kp.sizes_.size());
+    for (int i = 0; i < num_items; i++) {
+        if (!IsActiveItem(kp, raster, i)) continue;
+        if (IsBoundedItem(kp, raster, i)) {
+            for (int count = 1, rest = kp.bounds_[i]; rest > 0; count *= 2) {
+                int piece_count = min(count, rest);
+                kp.piece_items_.push_back(i);
+                kp.piece_counts_.push_back(piece_count);
+                rest -= piece_count;
+            }
+            continue;
+        }
+
+        int size = kp.sizes_[i];
+        double val = kp.values_[i];
+        if (use_grid) {
+            int step = size / gcd_val;
+            int end = static_cast<int>(num_cells);
+            for (int q = step; q < end; q++) {
+                double cand = grid[q - step] + val;
+                if (cand > grid[q]) {
+                    grid[q] = cand;
+                    grid_last[q] = i;
+                }
+            }
+            continue;
+        }
+
+        int next = 0;
+        for (int k = 0; k < num_points; k++) {
+            if (points[k] + size > capacity) break;
+
+            while (points[next] < points[k] + size) next++;
+            double cand = dp[k] + val;
+            if (cand > dp[next]) {
+                dp[next] = cand;
+                last_item[next] = i;
+            }
+        }
+    }
+
+    // 映射回可达位置
+    if (kp.grid_last_) {
+        for (int k = 0; k < num_points; k++) {
+            dp[k] = grid[points[k] / gcd_val];
+        }
+    }
+
+    int num_pieces = static_cast<int>(kp.piece_items_.size());
+    kp.last_piece_.assign(num_points, -1);
+    if (num_pieces > 0) {
+        kp.piece_base_dp_.assign(dp, dp + num_points);
+    }
+    for (int p = 0; p < num_pieces; p++) {
+        RelaxPiece(kp, p, dp, kp.last_piece_.data());
+    }
+
+    FinishKnapsackDP(kp);
+    return dp[num_points - 1];
+}
+
+// 定点DP: 在按gcd缩放后的稠密网格上展开, 由SIMD内核按块无分支松弛
+// 价值按比例S向下取整为整数: S = floor(B / (N + 1)) / v_max, N为方案物品数上限,
+// 保证任意方案的定点价值不超过B. 每个物品的舍入误差不超过1/S, 故
+//   真实最优值 <= (定点最优值 + N + 1) / S = bound  (多加的1吸收浮点乘法的舍入)
+// 最优定点方案的真实价值v由回溯精确计算. bound <= threshold时可确定无改进列,
+// v > threshold时可确定找到改进列; 否则无法判定, 返回false由调用方回退双精度DP
+// 定点内核不区分数量上限 (按完全背包展开), bound同样是有界问题的上界;
+// 最优定点方案超出数量上限时无法判定改进列, 同样回退双精度DP
+static bool SolveKnapsackFixed(KnapsackDP& kp, const RasterPoints& raster,
+    double threshold, double& bound) {
+
+    int num_points = static_cast<int>(raster.points_.size());
+    int gcd_val = raster.gcd_;
+    int num_cells = raster.capacity_ / gcd_val + 1;
+    int num_items = static_cast<int>(kp.sizes_.size());
+
+    double max_val = 0.0;
+    int min_size = num_cells;
+    for (int i = 0; i < num_items; i++) {
+        if (!IsActiveItem(kp, raster, i)) continue;
+        max_val = max(max_val, kp.values_[i]);
+        min_size = min(min_size, kp.sizes_[i] / gcd_val);
+    }
+
+    // 不可达位置取极小值, 可达位置从0出发 (与双精度DP相同, 方案可从任一可达位置起算)
+    kp.piece_items_.clear();
+    kp.grid_last_ = false;
+    kp.fixed_dp_.assign(num_cells, kFixedUnreachable);
+    kp.fixed_last_.assign(num_cells, -1);
+    for (int pos : raster.points_) {
+        kp.fixed_dp_[pos / gcd_val] = 0;
+    }
+
+    int max_count = 0;
+    double scale = 1.0;
+    if (max_val > 0) {
+        max_count = (num_cells - 1) / min_size;
+        scale = static_cast<double>(kFixedValueBudget / (max_count + 1)) / max_val;
+
+        int simd_level = DetectSimdLevel();
+        for (int i = 0; i < num_items; i++) {
+            if (!IsActiveItem(kp, raster, i)) continue;
+
+            int size = kp.sizes_[i];
+            int32_t value = static_cast<int32_t>(floor(kp.values_[i] * scale));
+            RelaxFixedItem(simd_level, kp.fixed_dp_.data(), kp.fixed_last_.data(),
+                num_cells, size / gcd_val, value, i);
+        }
+    }
+
+    // 映射回可达位置
+    kp.dp_.resize(num_points);
+    kp.last_item_.resize(num_points);
+    int32_t best_fixed = 0;
+    for (int k = 0; k < num_points; k++) {
+        int q = raster.points_[k] / gcd_val;
+        kp.dp_[k] = kp.fixed_dp_[q] / scale;
+        kp.last_item_[k] = kp.fixed_last_[q];
+        best_fixed = max(best_fixed, kp.fixed_dp_[q]);
+    }
+    FinishKnapsackDP(kp);
+    kp.num_fixed_solves_++;
+
+    kp.dp_error_ = (max_count + 1.0) / scale;
+    bound = best_fixed / scale + kp.dp_error_;
+    if (bound <= threshold) {
+        return true;
+    }
+
+    vector<int> pattern;
+    RebuildDPPattern(kp, num_points - 1, pattern);
+    double best_val = 0.0;
+    for (int i = 0; i < num_items; i++) {
+        best_val += pattern[i] * kp.values_[i];
+    }
+    if (best_val > threshold && WithinBounds(kp, pattern)) {
+        return true;
+    }
+
+    kp.num_exact_fallbacks_++;
+    return false;
+}
+
+// 求解背包: max sum(v_i * n_i), s.t. sum(s_i * n_i) <= capacity, n_i <= bounds_[i]
+// threshold: 改进阈值, 定点内核据此判定舍入误差是否影响结论
+// 返回: 容量内最大价值 (定点内核返回其上界, 与阈值的大小关系与精确值一致)
+double SolveKnapsackDP(ProblemParams& params, KnapsackDP& kp,
+    const RasterPoints& raster, double threshold) {
+
+    kp.raster_ = &raster;
+
+    // 数量上限起作用时定点内核的完全背包最优方案几乎总是超限, 直接用双精度DP
+    bool bounded = false;
+    for (int i = 0; i < (int)kp.sizes_.size(); i++) {
+        if (IsActiveItem(kp, raster, i) && IsBoundedItem(kp, raster, i)) {
+            bounded = true;
+            break;
+        }
+    }
+
+    // 定点内核的稠密网格有 容量/gcd + 1 个格点, 只在可达位置足够稠密时使用
+    int num_points = static_cast<int>(raster.points_.size());
+    long long num_cells = raster.capacity_ / raster.gcd_ + 1LL;
+    if (params.dp_kernel_ == kDPFixedPoint && !bounded &&
+        num_cells <= kDenseGridRatio * num_points) {
+        double bound = 0.0;
+        if (SolveKnapsackFixed(kp, raster, threshold, bound)) {
+            return bound;
+        }
+    }
+
+    return SolveKnapsackExact(kp, raster);
+}
+
+// 嵌套DP: 物品逐个加入同一张表, 每加入一批后可读出当前物品集合下的最优值与方案
+// 物品加入顺序不影响最优值, 因此物品集合嵌套的一组背包 (如按宽度升序的各条带类型)
+// 只需一次扫描. 每个物品作为一个阶段记录在piece_items_中:
+//   不限数量的物品 (件数0) 按位置升序作完全背包松弛, 有数量上限的物品二进制拆分为0-1阶段;
+// 每个位置记录最后一次严格改进它的阶段 (last_piece_), 回溯时按阶段逆序回退
+// 工作表保存在nested_dp_中, dp_只在读出时由其复制并取前缀最大值
+void BeginNestedDP(KnapsackDP& kp, const RasterPoints& raster, int num_items) {
+    PrepareKnapsackDP(kp, num_items);
+    int num_points = static_cast<int>(raster.points_.size());
+    kp.raster_ = &raster;
+    kp.nested_dp_.assign(num_points, 0.0);
+    kp.last_item_.assign(num_points, -1);
+    kp.piece_items_.clear();
+    kp.piece_counts_.clear();
+    kp.last_piece_.assign(num_points, -1);
+    kp.piece_base_dp_.assign(num_points, 0.0);
+    kp.grid_last_ = false;
+    kp.dp_error_ = 0.0;
+}
+
+// 向嵌套DP加入物品i (调用方已填写sizes_[i], values_[i], bounds_[i])
+void AddNestedDPItem(KnapsackDP& kp, int i) {
+    const RasterPoints& raster = *kp.raster_;
+    if (!IsActiveItem(kp, raster, i)) return;
+
+    vector<int> counts;
+    if (IsBoundedItem(kp, raster, i)) {
+        for (int count = 1, rest = kp.bounds_[i]; rest > 0; count *= 2) {
+            counts.push_back(min(count, rest));
+            rest -= counts.back();
+        }
+    } else {
+        counts.push_back(0);
+    }
+
+    for (int count : counts) {
+        kp.piece_items_.push_back(i);
+        kp.piece_counts_.push_back(count);
+        RelaxPiece(kp, static_cast<int>(kp.piece_items_.size()) - 1,
+            kp.nested_dp_.data(), kp.last_piece_.data());
+    }
+}
+
+// 读出嵌套DP当前物品集合下的最优值 (之后可调用ExtractDPPatterns提取方案)
+double ReadNestedDP(KnapsackDP& kp) {
+    kp.dp_ = kp.nested_dp_;
+    FinishKnapsackDP(kp);
+    return kp.dp_.back();
+}
+
+// 重建下标point处的最优方案: 先定位恰好占用的位置, 按阶段逆序回退0-1物品, 再沿回溯指针回退
+// 位置k处last_piece_[k] = p且p早于当前阶段上限时, 该位置在此之后未再改进, 按阶段p回退一件;
+// 否则该位置在后续阶段被改写, 所需的较早阶段价值已不在表中: 从piece_base_dp_重放上限之前的阶段
+// 重建指针后继续 (只在此时需要, 内存仍为O(|P|))
+// 嵌套DP的完全背包阶段 (件数0) 在同一阶段内可连续回退多件
+void RebuildDPPattern(const KnapsackDP& kp, int point, vector<int>& pattern) {
+    const RasterPoints& raster = *kp.raster_;
+    int num_points = static_cast<int>(raster.points_.size());
+    pattern.assign(kp.sizes_.size(), 0);
+    int k = kp.best_point_[point];
+
+    vector<double> replay_dp;
+    vector<int> replay_last;
+    const int* last_piece = kp.last_piece_.data();
+    int limit = static_cast<int>(kp.piece_items_.size());
+    while (limit > 0 && last_piece[k] >= 0) {
+        int p = last_piece[k];
+        if (p >= limit) {
+            replay_dp = kp.piece_base_dp_;
+            replay_last.assign(num_points, -1);
+            for (int q = 0; q < limit; q++) {
+                RelaxPiece(kp, q, replay_dp.data(), replay_last.data());
+            }
+            last_piece = replay_last.data();
+            continue;
+        }
+
+        int i = kp.piece_items_[p];
+        int count = max(1, kp.piece_counts_[p]);
+        pattern[i] += count;
+        k = FindPoint(raster, raster.points_[k] - kp.sizes_[i] * count);
+        limit = kp.piece_counts_[p] > 0 ? p : p + 1;    // 0-1物品至多放入一次
+    }
+    if (kp.grid_last_) {
+        for (int q = raster.points_[k] / raster.gcd_; kp.fixed_last_[q] >= 0; ) {
+            int i = kp.fixed_last_[q];
+            pattern[i]++;
+            q -= kp.sizes_[i] / raster.gcd_;
+        }
+        return;
+    }
+    while (kp.last_item_[k] >= 0) {
+        int i = kp.last_item_[k];
+        pattern[i]++;
+        k = FindPoint(raster, raster.points_[k] - kp.sizes_[i]);
+    }
+}
+
+// 从DP表中提取至多max_cols_per_sp_个互不相同的改进方案 (按价值降序)
+// dp_[k]为占用不超过第k个可达位置时的最优价值 (关于k单调不减)
+// 候选方案 (只记录 (价值, 基位置下标, 附加物品), 入选后才回溯重建):
+//   1. 以物品i收尾的方案 pattern(floor(C - s_i)) + e_i, floor为不超过该值的最大可达位置
+//   2. 较小位置下的最优方案 pattern(k), 从最后一个可达位置向下扫描直到价值不超过阈值
+void ExtractDPPatterns(ProblemParams& params, const KnapsackDP& kp,
+    double threshold, vector<vector<int>>& patterns) {
+
+    const vector<double>& dp = kp.dp_;
+    const RasterPoints& raster = *kp.raster_;
+    int last = static_cast<int>(dp.size()) - 1;
+    int capacity = raster.capacity_;
+    int max_cols = max(1, params.max_cols_per_sp_);
+
+    // dp_可能低估真实价值至多dp_error_ (定点内核), 候选筛选按放宽后的阈值
+    double loose_threshold = threshold - kp.dp_error_;
+
+    patterns.clear();
+    if (dp[last] <= loose_threshold) {
+        return;
+    }
+
+    struct Candidate {
+        double value_;
+        int base_;          // 基位置下标
+        int extra_item_;    // 附加物品 (-1=无)
+    };
+    vector<Candidate> candidates;
+    candidates.push_back({dp[last], last, -1});
+
+    if (max_cols > 1) {
+        for (int i = 0; i < (int)kp.sizes_.size(); i++) {
+            if (!IsActiveItem(kp, raster, i)) continue;
+
+            int base = FindFloorPoint(raster, capacity - kp.sizes_[i]);
+            double val = dp[base] + kp.values_[i];
+            if (val > loose_threshold) {
+                candidates.push_back({val, base, i});
+            }
+        }
+
+        // 价值阶跃处方案必然不同, 平台上的方案相同无需重复加入
+        int num_steps = 0;
+        for (int k = last - 1; k >= 0 && num_steps < max_cols; k--) {
+            if (dp[k] <= loose_threshold) break;
+            if (dp[k] < dp[k + 1]) {
+                candidates.push_back({dp[k], k, -1});
+                num_steps++;
+            }
+        }
+    }
+
+    stable_sort(candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& b) {
+            return a.value_ > b.value_;
+        });
+
+    set<vector<int>> seen;
+    vector<int> pattern;
+    for (const Candidate& cand : candidates) {
+        if ((int)patterns.size() >= max_cols) break;
+        RebuildDPPattern(kp, cand.base_, pattern);
+        if (cand.extra_item_ >= 0) {
+            pattern[cand.extra_item_]++;
+        }
+        if (!WithinBounds(kp, pattern)) continue;
+
+        // 按精确价值复核
+        double value = 0.0;
+        for (int i = 0; i < (int)pattern.size(); i++) {
+            value += pattern[i] * kp.values_[i];
+        }
+        if (value <= threshold) continue;
+
+        if (seen.insert(pattern).second) {
+            patterns.push_back(pattern);
+        }
+    }
+}
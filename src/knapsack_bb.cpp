@@ -0,0 +1,223 @@
+// =============================================================================
+// knapsack_bb.cpp - 背包分支定界 (容量远大于物品尺寸时替代DP)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+constexpr long long kBBNodeLimit = 2000000;    // 单次搜索节点数上限, 超过后回退DP
+constexpr int kBBMinCoreSize = 8;              // 核心问题的最小物品数
+
+// 按物品数重置工作区 (数量上限默认不限)
+void PrepareKnapsackBB(KnapsackBB& kb, int num_items) {
+    kb.sizes_.assign(num_items, 0);
+    kb.values_.assign(num_items, 0.0);
+    kb.bounds_.assign(num_items, INT_MAX);
+}
+
+// 搜索上下文: 参与搜索的物品按价值密度降序排列
+struct BBContext {
+    const int* sizes;
+    const double* values;
+    const int* bounds;
+    const double* ratios;       // 价值密度 v/s
+    int num_items;              // 参与搜索的物品数 (核心问题规模)
+    int max_cols;               // 保留的方案数
+    double threshold;           // 改进阈值
+};
+
+// 剪枝水平: 阈值与第k优方案价值的较大者
+static double PruneLevel(const KnapsackBB& kb, const BBContext& ctx) {
+    double level = ctx.threshold;
+    if ((int)kb.best_.size() >= ctx.max_cols) {
+        level = max(level, kb.best_.back().first);
+    }
+    return level;
+}
+
+// 记录叶子方案 (保持best_按价值降序且至多max_cols个)
+static void RecordSolution(KnapsackBB& kb, const BBContext& ctx, double value) {
+    if (value <= PruneLevel(kb, ctx)) {
+        kb.max_pruned_bound_ = max(kb.max_pruned_bound_, value);
+        return;
+    }
+
+    vector<int> pattern(kb.sizes_.size(), 0);
+    for (int k = 0; k < ctx.num_items; k++) {
+        pattern[kb.order_[k]] = kb.counts_[k];
+    }
+
+    auto pos = kb.best_.begin();
+    while (pos != kb.best_.end() && pos->first >= value) {
+        ++pos;
+    }
+    kb.best_.insert(pos, {value, pattern});
+    if ((int)kb.best_.size() > ctx.max_cols) {
+        kb.max_pruned_bound_ = max(kb.max_pruned_bound_, kb.best_.back().first);
+        kb.best_.pop_back();
+    }
+}
+
+// 深度优先搜索 (Martello-Toth式): 第k个物品依次取最大可行数量到0
+// 上界: 当前价值 + 剩余容量 * 剩余物品的最大价值密度 (LP松弛)
+// 返回: false=节点数超限
+static bool SearchBB(KnapsackBB& kb, const BBContext& ctx, int k, int rem, double value) {
+    if (++kb.num_nodes_ > kBBNodeLimit) {
+        return false;
+    }
+
+    // 剩余容量放不下任何物品时当前方案即为叶子
+    if (k == ctx.num_items || rem < kb.suffix_min_size_[k]) {
+        RecordSolution(kb, ctx, value);
+        return true;
+    }
+
+    double bound = value + rem * ctx.ratios[k];
+    if (bound <= PruneLevel(kb, ctx)) {
+        kb.max_pruned_bound_ = max(kb.max_pruned_bound_, bound);
+        return true;
+    }
+
+    int size = ctx.sizes[k];
+    int max_count = min(ctx.bounds[k], rem / size);
+    for (int n = max_count; n >= 0; n--) {
+        kb.counts_[k] = n;
+        if (!SearchBB(kb, ctx, k + 1, rem - n * size, value + n * ctx.values[k])) {
+            kb.counts_[k] = 0;
+            return false;
+        }
+    }
+    kb.counts_[k] = 0;
+    return true;
+}
+
+// 求解 (有界/无界) 整数背包: max sum(v_i * n_i), s.t. sum(s_i * n_i) <= capacity, n_i <= u_i
+// 1. 支配消去 (仅对不限数量的物品): 若floor(s_j / s_i) * v_i >= v_j, 物品j可由若干个i替代
+// 2. 核心问题: 先只在价值密度最高的若干物品上搜索; 核心外物品j的方案价值不超过
+//    v_j + (C - s_j) * r_max, 该值不超过剪枝水平的物品可排除, 否则加入核心再搜索一次
+// 3. 深度优先分支定界, 保留价值超过threshold的前max_cols_per_sp_个方案
+// opt_val: 找到改进方案时为最优值, 否则为不超过threshold的上界
+// patterns: 改进方案 (价值降序)
+// 返回: false=搜索节点数超限, 结果无效 (调用方应回退DP)
+bool SolveKnapsackBB(ProblemParams& params, KnapsackBB& kb, int capacity,
+    double threshold, double& opt_val, vector<vector<int>>& patterns) {
+
+    int num_items = static_cast<int>(kb.sizes_.size());
+    kb.num_solves_++;
+    kb.num_nodes_ = 0;
+    kb.best_.clear();
+    kb.max_pruned_bound_ = 0.0;
+    patterns.clear();
+
+    // 候选物品, 按价值密度降序 (同密度尺寸小者优先)
+    vector<int> candidates;
+    for (int i = 0; i < num_items; i++) {
+        if (kb.values_[i] > 0 && kb.sizes_[i] > 0 && kb.sizes_[i] <= capacity &&
+            kb.bounds_[i] > 0) {
+            candidates.push_back(i);
+        }
+    }
+    sort(candidates.begin(), candidates.end(), [&kb](int a, int b) {
+        double lhs = kb.values_[a] * kb.sizes_[b];
+        double rhs = kb.values_[b] * kb.sizes_[a];
+        if (lhs != rhs) return lhs > rhs;
+        return kb.sizes_[a] < kb.sizes_[b];
+    });
+
+    // 支配消去
+    kb.order_.clear();
+    for (int j : candidates) {
+        bool dominated = false;
+        if (kb.bounds_[j] == INT_MAX) {
+            for (int i : kb.order_) {
+                if (kb.bounds_[i] == INT_MAX &&
+                    (kb.sizes_[j] / kb.sizes_[i]) * kb.values_[i] >= kb.values_[j]) {
+                    dominated = true;
+                    break;
+                }
+            }
+        }
+        if (!dominated) {
+            kb.order_.push_back(j);
+        }
+    }
+
+    int num_kept = static_cast<int>(kb.order_.size());
+    vector<int> sizes(num_kept);
+    vector<double> values(num_kept);
+    vector<int> bounds(num_kept);
+    vector<double> ratios(num_kept);
+    for (int k = 0; k < num_kept; k++) {
+        int i = kb.order_[k];
+        sizes[k] = kb.sizes_[i];
+        values[k] = kb.values_[i];
+        bounds[k] = kb.bounds_[i];
+        ratios[k] = values[k] / sizes[k];
+    }
+
+    BBContext ctx;
+    ctx.sizes = sizes.data();
+    ctx.values = values.data();
+    ctx.bounds = bounds.data();
+    ctx.ratios = ratios.data();
+    ctx.max_cols = max(1, params.max_cols_per_sp_);
+    ctx.threshold = threshold;
+    ctx.num_items = min(num_kept, kBBMinCoreSize);
+
+    kb.counts_.assign(num_kept, 0);
+    while (true) {
+        // 核心内物品的后缀最小尺寸
+        kb.suffix_min_size_.assign(ctx.num_items + 1, INT_MAX);
+        for (int k = ctx.num_items - 1; k >= 0; k--) {
+            kb.suffix_min_size_[k] = min(kb.suffix_min_size_[k + 1], sizes[k]);
+        }
+
+        if (!SearchBB(kb, ctx, 0, capacity, 0.0)) {
+            kb.num_node_limit_hits_++;
+            return false;
+        }
+        if (ctx.num_items == num_kept) {
+            break;
+        }
+
+        // 核心外物品检验: 不可能超过剪枝水平的物品排除, 其余物品调入核心
+        double level = PruneLevel(kb, ctx);
+        double max_ratio = ratios[0];
+        vector<int> core(kb.order_.begin(), kb.order_.begin() + ctx.num_items);
+        for (int k = ctx.num_items; k < num_kept; k++) {
+            double item_bound = values[k] + (capacity - sizes[k]) * max_ratio;
+            if (item_bound <= level) {
+                kb.max_pruned_bound_ = max(kb.max_pruned_bound_, item_bound);
+            } else {
+                core.push_back(kb.order_[k]);
+            }
+        }
+        if ((int)core.size() == ctx.num_items) {
+            break;
+        }
+
+        // 调入的物品密度不高于原核心, 重排后核心仍按密度降序, 已找到的方案保留
+        for (int k = ctx.num_items; k < (int)core.size(); k++) {
+            int i = core[k];
+            int pos = static_cast<int>(find(kb.order_.begin(), kb.order_.end(), i) - kb.order_.begin());
+            swap(kb.order_[k], kb.order_[pos]);
+            swap(sizes[k], sizes[pos]);
+            swap(values[k], values[pos]);
+            swap(bounds[k], bounds[pos]);
+            swap(ratios[k], ratios[pos]);
+        }
+        ctx.num_items = static_cast<int>(core.size());
+        kb.best_.clear();
+    }
+
+    if (kb.best_.empty()) {
+        opt_val = kb.max_pruned_bound_;
+    } else {
+        opt_val = kb.best_.front().first;
+        for (auto& entry : kb.best_) {
+            patterns.push_back(entry.second);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,142 @@
+// =============================================================================
+// knapsack_simd.cpp - 定点完全背包内核 (AVX2 / SSE4.1 / 标量, 运行时选择)
+// =============================================================================
+
+#include "2DBP.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CS_TARGET_AVX2
+#define CS_TARGET_SSE41
+#else
+#define CS_TARGET_AVX2 __attribute__((target("avx2")))
+#define CS_TARGET_SSE41 __attribute__((target("sse4.1")))
+#endif
+#endif
+
+using namespace std;
+
+// 检测CPU支持的SIMD级别
+static int DetectSimdLevelOnce() {
+    int level = kSimdScalar;
+#ifdef CS_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool has_sse41 = (info[2] & (1 << 19)) != 0;
+    bool has_osxsave = (info[2] & (1 << 27)) != 0;
+    bool has_avx = (info[2] & (1 << 28)) != 0;
+    bool has_avx2 = false;
+    if (has_osxsave && has_avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        has_avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool has_sse41 = __builtin_cpu_supports("sse4.1");
+    bool has_avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (has_avx2) {
+        level = kSimdAVX2;
+    } else if (has_sse41) {
+        level = kSimdSSE41;
+    }
+#endif
+    return level;
+}
+
+// 检测结果缓存 (局部静态变量初始化线程安全, 定价线程可并发调用)
+int DetectSimdLevel() {
+    static const int level = DetectSimdLevelOnce();
+    return level;
+}
+
+const char* SimdLevelName(int level) {
+    switch (level) {
+        case kSimdAVX2:  return "AVX2";
+        case kSimdSSE41: return "SSE4.1";
+        default:         return "标量";
+    }
+}
+
+// 标量松弛: 只在严格改进时更新
+static void RelaxFixedScalar(int32_t* dp, int32_t* last, int begin, int num_cells,
+    int size, int32_t value, int32_t item) {
+
+    for (int q = begin; q < num_cells; q++) {
+        int32_t cand = dp[q - size] + value;
+        if (cand > dp[q]) {
+            dp[q] = cand;
+            last[q] = item;
+        }
+    }
+}
+
+#ifdef CS_SIMD_X86
+// SSE4.1: 每次处理4个位置, 要求size >= 4 (源位置均已在本轮更新完毕)
+// 返回: 下一个未处理的位置
+CS_TARGET_SSE41
+static int RelaxFixedSSE41(int32_t* dp, int32_t* last, int begin, int num_cells,
+    int size, int32_t value, int32_t item) {
+
+    const __m128i value_vec = _mm_set1_epi32(value);
+    const __m128i item_vec = _mm_set1_epi32(item);
+
+    int q = begin;
+    for (; q + 4 <= num_cells; q += 4) {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dp + q - size));
+        __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dp + q));
+        __m128i cand = _mm_add_epi32(src, value_vec);
+        __m128i mask = _mm_cmpgt_epi32(cand, cur);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dp + q), _mm_max_epi32(cand, cur));
+
+        __m128i old_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last + q));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(last + q),
+            _mm_blendv_epi8(old_last, item_vec, mask));
+    }
+    return q;
+}
+
+// AVX2: 每次处理8个位置, 要求size >= 8
+CS_TARGET_AVX2
+static int RelaxFixedAVX2(int32_t* dp, int32_t* last, int begin, int num_cells,
+    int size, int32_t value, int32_t item) {
+
+    const __m256i value_vec = _mm256_set1_epi32(value);
+    const __m256i item_vec = _mm256_set1_epi32(item);
+
+    int q = begin;
+    for (; q + 8 <= num_cells; q += 8) {
+        __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + q - size));
+        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + q));
+        __m256i cand = _mm256_add_epi32(src, value_vec);
+        __m256i mask = _mm256_cmpgt_epi32(cand, cur);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dp + q), _mm256_max_epi32(cand, cur));
+
+        __m256i old_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last + q));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(last + q),
+            _mm256_blendv_epi8(old_last, item_vec, mask));
+    }
+    return q;
+}
+#endif
+
+// 用一个物品 (尺寸size, 定点价值value) 松弛整张定点DP表 (完全背包, 位置升序)
+// 位置q的源位置为q - size, size不小于向量宽度时同一块内的源位置都已更新完毕,
+// 因此按块无分支处理与逐位置处理结果相同; 尺寸较小的物品退回窄向量或标量
+void RelaxFixedItem(int simd_level, int32_t* dp, int32_t* last, int num_cells,
+    int size, int32_t value, int32_t item) {
+
+    int q = size;
+#ifdef CS_SIMD_X86
+    if (simd_level >= kSimdAVX2 && size >= 8) {
+        q = RelaxFixedAVX2(dp, last, q, num_cells, size, value, item);
+    } else if (simd_level >= kSimdSSE41 && size >= 4) {
+        q = RelaxFixedSSE41(dp, last, q, num_cells, size, value, item);
+    }
+#endif
+    RelaxFixedScalar(dp, last, q, num_cells, size, value, item);
+}
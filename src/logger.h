@@ -103,19 +103,28 @@ inline std::string GetTimestampString() {
 }
 
 
+// 当前线程的日志重定向流 (nullptr=标准输出)
+// 并行定价任务将日志写入各自的缓冲区, 全部完成后按任务顺序输出, 日志与串行求解一致
+inline thread_local std::ostream* log_redirect_stream = nullptr;
+
+inline std::ostream& LogStream() {
+    return log_redirect_stream ? *log_redirect_stream : std::cout;
+}
+
+
 // 日志输出宏
 
 // 带换行的日志输出
-#define LOG(msg) std::cout << msg << std::endl
+#define LOG(msg) LogStream() << msg << std::endl
 
 // 不带换行的日志输出
-#define LOG_NO_NL(msg) std::cout << msg
+#define LOG_NO_NL(msg) LogStream() << msg
 
 // 格式化日志输出
 #define LOG_FMT(fmt, ...) do { \
     char _log_buf[1024]; \
     snprintf(_log_buf, sizeof(_log_buf), fmt, ##__VA_ARGS__); \
-    std::cout << _log_buf; \
+    LogStream() << _log_buf; \
 } while(0)
 
 #endif  // LOGGER_H_
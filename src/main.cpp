@@ -31,10 +31,72 @@ int main() {
     ProblemData data;
     ProblemParams params;
 
-    // 设置子问题求解方法 (可选: kCplexIP, kArcFlow, kDP)
+    // 设置子问题求解方法 (可选: kCplexIP, kArcFlow, kDP, kBranchBound)
     params.sp1_method_ = kCplexIP;  // SP1: 宽度背包
     params.sp2_method_ = kCplexIP;  // SP2: 长度背包
 
+    // 设置DP背包内核 (可选: kDPExact, kDPFixedPoint; 后者为SIMD定点内核, 仅在DP求解时生效)
+    params.dp_kernel_ = kDPFixedPoint;
+
+    // 定价方案中子件数不超过需求, 条带数不超过可放入子件的需求之和 (对所有子问题方法生效)
+    params.demand_bounded_ = true;
+
+    // SP2先用贪心启发式定价, 找不到改进列时再调用上面设置的精确方法
+    params.heuristic_pricing_ = true;
+
+    // SP2定价缓存: 子件对偶价格未变时直接复用上次精确求解的结果
+    // 量化步长为0时精确匹配; 大于0时按步长量化, 命中后计入价格变化的误差上界
+    params.pricing_cache_ = true;
+    params.pricing_cache_quantum_ = 0.0;
+
+    // SP2上界跳过: LP松弛上界或上次求解的上界不超过v_j时不调用精确方法
+    params.sp2_bound_skip_ = true;
+
+    // SP2为DP时按条带宽度升序共用一张嵌套DP表, 一次扫描求出全部条带类型的SP2
+    params.nested_sp2_dp_ = true;
+
+    // CPLEX子问题模型常驻并用解池一次提取多列 (关闭时每次求解新建模型, 只取最优解)
+    // 尚未在CPLEX上与逐次建模对比实测, 默认关闭
+    params.resident_sp_models_ = false;
+
+    // 设置主问题LP求解后端 (可选: kMPCplex, kMPSimplex)
+    params.mp_method_ = kMPCplex;
+
+    // 设置定价对偶价格类型 (可选: kVertexDuals, kCentralDuals; 后者仅CPLEX后端支持)
+    // kCentralDuals每次重解都是不做crossover的冷启动内点法, 失去主问题的热启动,
+    // 与顶点对偶价格对比测试之前不作为默认设置
+    params.dual_mode_ = kVertexDuals;
+
+    // 设置定价轮次模式 (可选: kSequentialPricing, kBatchPricing, kJointPricing)
+    params.pricing_mode_ = kJointPricing;
+
+    // 每次子问题求解最多加入的改进列数 (DP从表中提取, CPLEX/Arc Flow从解池提取)
+    params.max_cols_per_sp_ = 5;
+
+    // 设置对偶稳定化 (可选: kNoStabilization, kSmoothing, kBoxStep)
+    // 内置单纯形后端的随机算例上两种稳定化的根节点迭代次数与耗时均高于不稳定化, 默认不启用
+    params.stab_mode_ = kNoStabilization;
+
+    // 列连续非基次数上限, 超过后从主问题中清除 (0=不清除)
+    params.column_max_age_ = 20;
+
+    // 定价前先扫描全局列池 (跨节点复用已生成的列)
+    params.use_column_pool_ = true;
+
+    // SP2并行定价线程数 (1=串行, 0=硬件线程数; 仅批量定价模式生效)
+    params.num_pricing_threads_ = 0;
+
+#ifdef CS_NO_CPLEX
+    // 无CPLEX构建: 主问题使用内置单纯形法, 依赖CPLEX的子问题方法改用DP
+    params.mp_method_ = kMPSimplex;
+    if (params.sp1_method_ == kCplexIP || params.sp1_method_ == kArcFlow) {
+        params.sp1_method_ = kDP;
+    }
+    if (params.sp2_method_ == kCplexIP || params.sp2_method_ == kArcFlow) {
+        params.sp2_method_ = kDP;
+    }
+#endif
+
     // 初始化根节点
     BPNode root_node;
     root_node.id_ = 1;
@@ -50,6 +112,16 @@ int main() {
         return 1;
     }
 
+    // 可达位置 (DP与Arc Flow共用, 首次使用时按需生成; 分支定界与CPLEX方法不生成)
+    InitRasterPoints(data, params);
+    if (params.dp_kernel_ == kDPFixedPoint) {
+        LOG_FMT("[DP] 定点背包内核指令集: %s\n", SimdLevelName(DetectSimdLevel()));
+    }
+
+    // 定价线程池与各线程的工作区
+    InitPricingPool(params);
+    InitPricingCache(params);
+
     // 如果使用Arc Flow方法, 生成网络
     if (params.sp1_method_ == kArcFlow || params.sp2_method_ == kArcFlow) {
         GenerateAllArcs(data, params);
@@ -92,6 +164,11 @@ int main() {
         RunBranchAndPrice(params, data, &root_node);
     }
 
+#ifndef CS_NO_CPLEX
+    // 释放常驻子问题模型
+    EndSPModels(data);
+#endif
+
     // 计算耗时
     auto end_time = chrono::high_resolution_clock::now();
     auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time);
@@ -103,8 +180,55 @@ int main() {
     LOG("============================================================");
     LOG_FMT("  最优目标值 (母板数): %.4f\n", params.global_best_int_);
     LOG_FMT("  根节点下界: %.4f\n", root_node.lower_bound_);
+    LOG_FMT("  根节点主问题目标值: %.4f\n", root_node.solution_.obj_val_);
     LOG_FMT("  最优性间隙: %.2f%%\n", params.gap_ * 100);
     LOG_FMT("  分支节点数: %d\n", params.node_counter_);
+    LOG_FMT("  清除列数: %d\n", params.num_purged_cols_);
+    LOG_FMT("  列池规模: Y=%d, X=%d\n",
+        (int)params.column_pool_.y_cols_.size(), (int)params.column_pool_.x_cols_.size());
+    LOG_FMT("  子问题调用: %d次 (列池节省%d次)\n",
+        params.column_pool_.oracle_calls_, params.column_pool_.saved_calls_);
+    // 各定价线程工作区的统计之和
+    PricingWorkspace total_stats;
+    for (const PricingWorkspace& ws : params.workspaces_) {
+        total_stats.knapsack_bb_.num_solves_ += ws.knapsack_bb_.num_solves_;
+        total_stats.knapsack_bb_.num_node_limit_hits_ += ws.knapsack_bb_.num_node_limit_hits_;
+        total_stats.knapsack_dp_.num_fixed_solves_ += ws.knapsack_dp_.num_fixed_solves_;
+        total_stats.knapsack_dp_.num_exact_fallbacks_ += ws.knapsack_dp_.num_exact_fallbacks_;
+        total_stats.num_heuristic_hits_ += ws.num_heuristic_hits_;
+    }
+    if (params.heuristic_pricing_) {
+        LOG_FMT("  启发式定价: 命中%d次\n", total_stats.num_heuristic_hits_);
+    }
+    if (params.pricing_cache_) {
+        int num_lookups = 0;
+        int num_hits = 0;
+        for (const PricingCache& cache : params.pricing_caches_) {
+            num_lookups += cache.num_lookups_;
+            num_hits += cache.num_hits_;
+        }
+        LOG_FMT("  定价缓存: 查询%d次, 命中%d次 (%.1f%%)\n", num_lookups, num_hits,
+            (num_lookups > 0) ? 100.0 * num_hits / num_lookups : 0.0);
+    }
+    if (params.sp2_bound_skip_) {
+        int num_lp_skips = 0;
+        int num_last_skips = 0;
+        for (const PricingCache& cache : params.pricing_caches_) {
+            num_lp_skips += cache.num_lp_skips_;
+            num_last_skips += cache.num_last_skips_;
+        }
+        LOG_FMT("  SP2上界跳过: %d次 (LP松弛界%d次, 上次求解界%d次)\n",
+            num_lp_skips + num_last_skips, num_lp_skips, num_last_skips);
+    }
+    if (params.sp1_method_ == kBranchBound || params.sp2_method_ == kBranchBound) {
+        LOG_FMT("  分支定界: %d次 (节点数超限回退DP %d次)\n",
+            total_stats.knapsack_bb_.num_solves_, total_stats.knapsack_bb_.num_node_limit_hits_);
+    }
+    if (params.dp_kernel_ == kDPFixedPoint) {
+        LOG_FMT("  定点DP: %d次 (回退双精度%d次)\n",
+            total_stats.knapsack_dp_.num_fixed_solves_,
+            total_stats.knapsack_dp_.num_exact_fallbacks_);
+    }
     LOG_FMT("  总耗时: %.3f 秒\n", elapsed_sec);
     LOG("============================================================");
 
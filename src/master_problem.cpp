@@ -0,0 +1,487 @@
+// =============================================================================
+// master_problem.cpp - 主问题LP管理 (根节点与非根节点共用)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 初始化主问题LP
+// 建立约束行, 列由调用方随后逐列加入:
+//   sum(C_jk*y_k) - sum(x_p) >= 0   (条带平衡约束, 行0~J-1)
+//   sum(B_ip*x_p) >= d_i            (子件需求约束, 行J~J+N-1)
+void InitMasterLP(ProblemParams& params, ProblemData& data, MasterLP& mp) {
+    int num_strip_types = params.num_strip_types_;
+    int num_item_types = params.num_item_types_;
+
+    mp.method_ = params.mp_method_;
+    mp.dual_mode_ = params.dual_mode_;
+    mp.y_ubs_.clear();
+    mp.x_ubs_.clear();
+    mp.y_var_ids_.clear();
+    mp.x_var_ids_.clear();
+
+    mp.solve_count_ = 0;
+    mp.solve_time_ = 0.0;
+    mp.last_solve_time_ = 0.0;
+
+    if (mp.method_ == kMPSimplex) {
+        vector<double> rhs(num_strip_types, 0.0);
+        for (int i = 0; i < num_item_types; i++) {
+            rhs.push_back(data.item_types_[i].demand_);
+        }
+        InitSimplexLP(mp.simplex_, rhs);
+
+        // 内置单纯形法只能给出顶点对偶价格
+        if (mp.dual_mode_ == kCentralDuals) {
+            mp.dual_mode_ = kVertexDuals;
+        }
+        return;
+    }
+
+#ifndef CS_NO_CPLEX
+    mp.model_ = IloModel(mp.env_);
+    mp.obj_ = IloAdd(mp.model_, IloMinimize(mp.env_));
+    mp.y_vars_ = IloNumVarArray(mp.env_);
+    mp.x_vars_ = IloNumVarArray(mp.env_);
+
+    IloNumArray con_min(mp.env_);
+    IloNumArray con_max(mp.env_);
+
+    for (int j = 0; j < num_strip_types; j++) {
+        con_min.add(0);
+        con_max.add(IloInfinity);
+    }
+
+    for (int i = 0; i < num_item_types; i++) {
+        con_min.add(data.item_types_[i].demand_);
+        con_max.add(IloInfinity);
+    }
+
+    mp.cons_ = IloRangeArray(mp.env_, con_min, con_max);
+    mp.model_.add(mp.cons_);
+    con_min.end();
+    con_max.end();
+#endif
+}
+
+// Y列的稀疏系数: 条带平衡行j的系数为pattern[j] (子件需求行均为0, 不存储)
+SparseColumn BuildYColumnCoefs(ProblemParams& params, const vector<int>& pattern) {
+    SparseColumn col;
+    for (int j = 0; j < params.num_strip_types_; j++) {
+        if (pattern[j] != 0) {
+            col.push_back({j, static_cast<double>(pattern[j])});
+        }
+    }
+    return col;
+}
+
+// X列的稀疏系数: 所属条带行为-1, 子件需求行J+i为pattern[i]
+SparseColumn BuildXColumnCoefs(ProblemParams& params, int strip_type,
+    const vector<int>& pattern) {
+
+    int num_strip_types = params.num_strip_types_;
+
+    SparseColumn col;
+    col.push_back({strip_type, -1.0});
+    for (int i = 0; i < params.num_item_types_; i++) {
+        if (pattern[i] != 0) {
+            col.push_back({num_strip_types + i, static_cast<double>(pattern[i])});
+        }
+    }
+    return col;
+}
+
+// 向主问题加入一列 (稀疏系数, Y列目标系数=1, X列目标系数=0)
+// 模型已提取时, CPLEX增量接收新列, 不会重建模型
+// var_ub: 变量上界 (INFINITY表示无上界)
+// 返回: 内置单纯形法的变量编号 (CPLEX后端为-1)
+static int AddColumnToMP(MasterLP& mp, const SparseColumn& col, bool is_y_col,
+    double var_ub, [[maybe_unused]] const string& var_name) {
+
+    double cost = is_y_col ? 1.0 : 0.0;
+
+    if (mp.method_ == kMPSimplex) {
+        return AddSimplexColumn(mp.simplex_, col, cost, var_ub);
+    }
+
+#ifndef CS_NO_CPLEX
+    IloNumColumn cplex_col = mp.obj_(cost);
+    for (auto& [row, coef] : col) {
+        cplex_col += mp.cons_[row](coef);
+    }
+
+    IloNumVar var(cplex_col, 0, min(var_ub, (double)IloInfinity), ILOFLOAT, var_name.c_str());
+    if (is_y_col) {
+        mp.y_vars_.add(var);
+    } else {
+        mp.x_vars_.add(var);
+    }
+    cplex_col.end();
+#endif
+    return -1;
+}
+
+// 向主问题加入一个Y列
+void AddYColumnToMP(ProblemParams& params, MasterLP& mp,
+    const vector<int>& pattern, double var_ub, int col_id) {
+
+    SparseColumn col = BuildYColumnCoefs(params, pattern);
+    int var_id = AddColumnToMP(mp, col, true, var_ub, "Y_" + to_string(col_id));
+
+    mp.y_var_ids_.push_back(var_id);
+    mp.y_ubs_.push_back(var_ub);
+}
+
+// 向主问题加入一个X列
+void AddXColumnToMP(ProblemParams& params, MasterLP& mp,
+    int strip_type, const vector<int>& pattern, double var_ub, int col_id) {
+
+    SparseColumn col = BuildXColumnCoefs(params, strip_type, pattern);
+    int var_id = AddColumnToMP(mp, col, false, var_ub, "X_" + to_string(col_id));
+
+    mp.x_var_ids_.push_back(var_id);
+    mp.x_ubs_.push_back(var_ub);
+}
+
+// 内置单纯形法求解, 结果写入mp
+static bool SolveSimplexMP([[maybe_unused]] ProblemParams& params, MasterLP& mp, BPNode& node) {
+    if (!SolveSimplexLP(mp.simplex_)) {
+        return false;
+    }
+
+    mp.obj_val_ = mp.simplex_.obj_val_;
+    node.duals_ = mp.simplex_.duals_;
+
+    vector<double> values;
+    GetSimplexValues(mp.simplex_, values);
+
+    int num_y_cols = static_cast<int>(mp.y_var_ids_.size());
+    int num_x_cols = static_cast<int>(mp.x_var_ids_.size());
+    mp.y_values_.resize(num_y_cols);
+    mp.y_rcs_.resize(num_y_cols);
+    mp.x_values_.resize(num_x_cols);
+    mp.x_rcs_.resize(num_x_cols);
+
+    for (int col = 0; col < num_y_cols; col++) {
+        mp.y_values_[col] = values[mp.y_var_ids_[col]];
+        mp.y_rcs_[col] = GetSimplexReducedCost(mp.simplex_, mp.y_var_ids_[col]);
+    }
+    for (int col = 0; col < num_x_cols; col++) {
+        mp.x_values_[col] = values[mp.x_var_ids_[col]];
+        mp.x_rcs_[col] = GetSimplexReducedCost(mp.simplex_, mp.x_var_ids_[col]);
+    }
+
+    return true;
+}
+
+#ifndef CS_NO_CPLEX
+// SimplexVarStatus与CPLEX基状态互相转换
+static IloCplex::BasisStatus ToCplexStatus(int status) {
+    if (status == kVarBasic) return IloCplex::Basic;
+    if (status == kVarAtUpper) return IloCplex::AtUpper;
+    return IloCplex::AtLower;
+}
+
+static int FromCplexStatus(IloCplex::BasisStatus status) {
+    if (status == IloCplex::Basic) return kVarBasic;
+    if (status == IloCplex::AtUpper) return kVarAtUpper;
+    return kVarAtLower;
+}
+
+// 向已提取的CPLEX模型载入热启动基
+// 返回: true=已载入
+static bool ApplyCplexStartBasis(MasterLP& mp) {
+    if (mp.start_row_status_.empty()) {
+        return false;
+    }
+
+    IloNumVarArray all_vars(mp.env_);
+    all_vars.add(mp.y_vars_);
+    all_vars.add(mp.x_vars_);
+
+    IloCplex::BasisStatusArray col_stat(mp.env_);
+    IloCplex::BasisStatusArray row_stat(mp.env_);
+    for (int status : mp.start_col_status_) {
+        col_stat.add(ToCplexStatus(status));
+    }
+    for (int status : mp.start_row_status_) {
+        row_stat.add(ToCplexStatus(status));
+    }
+
+    mp.cplex_.setBasisStatuses(col_stat, all_vars, row_stat, mp.cons_);
+
+    col_stat.end();
+    row_stat.end();
+    all_vars.end();
+    mp.start_col_status_.clear();
+    mp.start_row_status_.clear();
+    return true;
+}
+
+// CPLEX求解, 结果写入mp
+// 首次调用时提取模型; 之后的求解使用primal simplex从上次的基热启动
+// (新增列以非基变量加入, 原最优基保持原始可行)
+// 中心对偶模式: 使用内点法且不做crossover, 对偶价格位于对偶最优面内部,
+// 不会在退化主问题的各个顶点之间跳动 (代价是无法热启动)
+static bool SolveCplexMP(ProblemParams& params, MasterLP& mp, BPNode& node) {
+    bool warm_start = false;
+    if (mp.solve_count_ == 0) {
+        mp.cplex_ = IloCplex(mp.env_);
+        mp.cplex_.setOut(mp.env_.getNullStream());
+        mp.cplex_.extract(mp.model_);
+        warm_start = ApplyCplexStartBasis(mp);
+    }
+
+    if (warm_start) {
+        // 父节点最优基在新分支上界下仍对偶可行, 用对偶单纯形重新优化
+        mp.cplex_.setParam(IloCplex::AdvInd, 1);
+        mp.cplex_.setParam(IloCplex::RootAlg, IloCplex::Dual);
+    } else if (mp.dual_mode_ == kCentralDuals) {
+        mp.cplex_.setParam(IloCplex::RootAlg, IloCplex::Barrier);
+        mp.cplex_.setParam(IloCplex::BarCrossAlg, -1);
+    } else if (mp.solve_count_ > 0) {
+        mp.cplex_.setParam(IloCplex::AdvInd, 1);
+        mp.cplex_.setParam(IloCplex::RootAlg, IloCplex::Primal);
+        mp.cplex_.setParam(IloCplex::BarCrossAlg, 0);
+    }
+
+    if (!mp.cplex_.solve()) {
+        return false;
+    }
+
+    mp.obj_val_ = mp.cplex_.getValue(mp.obj_);
+
+    // 提取对偶价格
+    int num_rows = params.num_strip_types_ + params.num_item_types_;
+    node.duals_.clear();
+    for (int row = 0; row < num_rows; row++) {
+        double dual = mp.cplex_.getDual(mp.cons_[row]);
+        if (dual == -0.0) dual = 0.0;
+        node.duals_.push_back(dual);
+    }
+
+    // 提取列取值与检验数
+    int num_y_cols = static_cast<int>(mp.y_vars_.getSize());
+    int num_x_cols = static_cast<int>(mp.x_vars_.getSize());
+    mp.y_values_.resize(num_y_cols);
+    mp.y_rcs_.resize(num_y_cols);
+    mp.x_values_.resize(num_x_cols);
+    mp.x_rcs_.resize(num_x_cols);
+
+    IloNumArray vals(mp.env_);
+    IloNumArray rcs(mp.env_);
+    mp.cplex_.getValues(vals, mp.y_vars_);
+    mp.cplex_.getReducedCosts(rcs, mp.y_vars_);
+    for (int col = 0; col < num_y_cols; col++) {
+        mp.y_values_[col] = vals[col];
+        mp.y_rcs_[col] = rcs[col];
+    }
+    mp.cplex_.getValues(vals, mp.x_vars_);
+    mp.cplex_.getReducedCosts(rcs, mp.x_vars_);
+    for (int col = 0; col < num_x_cols; col++) {
+        mp.x_values_[col] = vals[col];
+        mp.x_rcs_[col] = rcs[col];
+    }
+    vals.end();
+    rcs.end();
+
+    return true;
+}
+#endif
+
+// 求解主问题LP并提取对偶价格、列取值与检验数
+bool SolveMasterLP(ProblemParams& params, MasterLP& mp, BPNode& node) {
+    auto start = chrono::steady_clock::now();
+
+    bool feasible = false;
+    if (mp.method_ == kMPSimplex) {
+        feasible = SolveSimplexMP(params, mp, node);
+    }
+#ifndef CS_NO_CPLEX
+    else {
+        feasible = SolveCplexMP(params, mp, node);
+    }
+#endif
+
+    auto end = chrono::steady_clock::now();
+    mp.last_solve_time_ = chrono::duration<double>(end - start).count();
+    mp.solve_time_ += mp.last_solve_time_;
+    mp.solve_count_++;
+
+    if (!feasible) {
+        return false;
+    }
+
+    node.mp_obj_val_ = mp.obj_val_;
+    LOG_FMT("[MP] 目标值: %.4f (耗时 %.3f ms)\n", mp.obj_val_, mp.last_solve_time_ * 1000);
+
+    return true;
+}
+
+// 从主问题中删除列 (y_flags[col]/x_flags[col]=1表示删除)
+// 只删除非基变量, 当前基保持可用; 内置单纯形拒绝删除的列 (基变量) 标志清零,
+// 调用方据此在节点中保留这些列
+void RemoveColumnsFromMP(MasterLP& mp, vector<int>& y_flags, vector<int>& x_flags) {
+
+    int num_y_cols = static_cast<int>(y_flags.size());
+    int num_x_cols = static_cast<int>(x_flags.size());
+
+    if (mp.method_ == kMPSimplex) {
+        vector<int> remove_flags(mp.simplex_.cols_.size(), 0);
+        for (int col = 0; col < num_y_cols; col++) {
+            remove_flags[mp.y_var_ids_[col]] = y_flags[col];
+        }
+        for (int col = 0; col < num_x_cols; col++) {
+            remove_flags[mp.x_var_ids_[col]] = x_flags[col];
+        }
+        vector<int> new_index = RemoveSimplexColumns(mp.simplex_, remove_flags);
+        for (int col = 0; col < num_y_cols; col++) {
+            if (new_index[mp.y_var_ids_[col]] >= 0) {
+                y_flags[col] = 0;
+            }
+        }
+        for (int col = 0; col < num_x_cols; col++) {
+            if (new_index[mp.x_var_ids_[col]] >= 0) {
+                x_flags[col] = 0;
+            }
+        }
+        for (int& id : mp.y_var_ids_) {
+            id = new_index[id];
+        }
+        for (int& id : mp.x_var_ids_) {
+            id = new_index[id];
+        }
+    }
+
+    // 从后往前删除, 使未处理的下标保持不变
+    for (int col = num_y_cols - 1; col >= 0; col--) {
+        if (y_flags[col] != 1) continue;
+#ifndef CS_NO_CPLEX
+        if (mp.method_ == kMPCplex) {
+            mp.y_vars_[col].end();
+            mp.y_vars_.remove(col);
+        }
+#endif
+        mp.y_var_ids_.erase(mp.y_var_ids_.begin() + col);
+        mp.y_ubs_.erase(mp.y_ubs_.begin() + col);
+        mp.y_values_.erase(mp.y_values_.begin() + col);
+        mp.y_rcs_.erase(mp.y_rcs_.begin() + col);
+    }
+    for (int col = num_x_cols - 1; col >= 0; col--) {
+        if (x_flags[col] != 1) continue;
+#ifndef CS_NO_CPLEX
+        if (mp.method_ == kMPCplex) {
+            mp.x_vars_[col].end();
+            mp.x_vars_.remove(col);
+        }
+#endif
+        mp.x_var_ids_.erase(mp.x_var_ids_.begin() + col);
+        mp.x_ubs_.erase(mp.x_ubs_.begin() + col);
+        mp.x_values_.erase(mp.x_values_.begin() + col);
+        mp.x_rcs_.erase(mp.x_rcs_.begin() + col);
+    }
+}
+
+// 保存最终主问题的基状态到节点 (供子节点热启动)
+void SaveMasterBasis(MasterLP& mp, BPNode& node) {
+    int num_y_cols = static_cast<int>(mp.y_var_ids_.size());
+    int num_x_cols = static_cast<int>(mp.x_var_ids_.size());
+
+    node.y_basis_status_.assign(num_y_cols, kVarAtLower);
+    node.x_basis_status_.assign(num_x_cols, kVarAtLower);
+
+    if (mp.method_ == kMPSimplex) {
+        SimplexLP& lp = mp.simplex_;
+        for (int col = 0; col < num_y_cols; col++) {
+            node.y_basis_status_[col] = lp.status_[mp.y_var_ids_[col]];
+        }
+        for (int col = 0; col < num_x_cols; col++) {
+            node.x_basis_status_[col] = lp.status_[mp.x_var_ids_[col]];
+        }
+        // 剩余变量编号与行号相同
+        node.row_basis_status_.assign(lp.status_.begin(), lp.status_.begin() + lp.num_rows_);
+        return;
+    }
+
+#ifndef CS_NO_CPLEX
+    IloNumVarArray all_vars(mp.env_);
+    all_vars.add(mp.y_vars_);
+    all_vars.add(mp.x_vars_);
+
+    IloCplex::BasisStatusArray col_stat(mp.env_);
+    IloCplex::BasisStatusArray row_stat(mp.env_);
+    mp.cplex_.getBasisStatuses(col_stat, all_vars, row_stat, mp.cons_);
+
+    for (int col = 0; col < num_y_cols; col++) {
+        node.y_basis_status_[col] = FromCplexStatus(col_stat[col]);
+    }
+    for (int col = 0; col < num_x_cols; col++) {
+        node.x_basis_status_[col] = FromCplexStatus(col_stat[num_y_cols + col]);
+    }
+    int num_rows = static_cast<int>(mp.cons_.getSize());
+    node.row_basis_status_.assign(num_rows, kVarAtLower);
+    for (int row = 0; row < num_rows; row++) {
+        node.row_basis_status_[row] = FromCplexStatus(row_stat[row]);
+    }
+
+    col_stat.end();
+    row_stat.end();
+    all_vars.end();
+#endif
+}
+
+// 载入节点保存的基作为主问题的初始基 (列集合须与保存时一致)
+// 内置单纯形法立即载入; CPLEX在首次求解提取模型后载入
+// 返回: true=基可用
+bool LoadMasterBasis(MasterLP& mp, BPNode& node) {
+    int num_y_cols = static_cast<int>(mp.y_var_ids_.size());
+    int num_x_cols = static_cast<int>(mp.x_var_ids_.size());
+
+    if ((int)node.y_basis_status_.size() != num_y_cols ||
+        (int)node.x_basis_status_.size() != num_x_cols ||
+        node.row_basis_status_.empty()) {
+        return false;
+    }
+
+    if (mp.method_ == kMPSimplex) {
+        SimplexLP& lp = mp.simplex_;
+        vector<int> status(lp.cols_.size(), kVarAtLower);
+        for (int row = 0; row < lp.num_rows_; row++) {
+            status[row] = node.row_basis_status_[row];
+        }
+        for (int col = 0; col < num_y_cols; col++) {
+            status[mp.y_var_ids_[col]] = node.y_basis_status_[col];
+        }
+        for (int col = 0; col < num_x_cols; col++) {
+            status[mp.x_var_ids_[col]] = node.x_basis_status_[col];
+        }
+        return SetSimplexBasis(lp, status);
+    }
+
+    mp.start_col_status_ = node.y_basis_status_;
+    mp.start_col_status_.insert(mp.start_col_status_.end(),
+        node.x_basis_status_.begin(), node.x_basis_status_.end());
+    mp.start_row_status_ = node.row_basis_status_;
+    return true;
+}
+
+// 释放主问题LP资源并输出求解统计
+void EndMasterLP(MasterLP& mp) {
+    if (mp.solve_count_ > 0) {
+        LOG_FMT("[MP] %s求解%d次, 总耗时 %.3f ms, 平均 %.3f ms/次\n",
+            (mp.method_ == kMPSimplex) ? "内置单纯形" : "CPLEX",
+            mp.solve_count_, mp.solve_time_ * 1000,
+            mp.solve_time_ * 1000 / mp.solve_count_);
+    }
+    if (mp.method_ == kMPSimplex) {
+        LOG_FMT("[MP] 单纯形累计换基 %d 次\n", mp.simplex_.total_iters_);
+    }
+
+#ifndef CS_NO_CPLEX
+    if (mp.method_ == kMPCplex && mp.solve_count_ > 0) {
+        mp.cplex_.end();
+    }
+    mp.env_.end();
+#endif
+}
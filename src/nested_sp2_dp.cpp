@@ -0,0 +1,68 @@
+// =============================================================================
+// nested_sp2_dp.cpp - 嵌套DP: 一次扫描求解全部条带类型的SP2
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 条带类型j允许的子件为宽度不超过其宽度的子件, 较宽条带的子件集合包含较窄条带的.
+// 条带类型按宽度升序处理, 每处理一种先把新允许的子件加入同一张DP表, 再读出该条带的最优值,
+// J次完整DP合并为对子件的一次扫描. 可达位置取最宽条带的 (包含较窄条带的全部可达位置)
+// strip_ids中各条带类型的最优值写入node.sp2_bounds_, 改进方案 (至多max_cols_per_sp_个) 写入patterns
+void SolveNestedSP2DP(ProblemParams& params, ProblemData& data, BPNode& node,
+    const vector<int>& strip_ids, vector<vector<vector<int>>>& patterns) {
+
+    int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
+    int num_strips = static_cast<int>(strip_ids.size());
+
+    patterns.assign(num_strips, vector<vector<int>>());
+    if (num_strips == 0) {
+        return;
+    }
+
+    // 条带按宽度升序, 子件按宽度升序
+    vector<int> strip_order(num_strips);
+    iota(strip_order.begin(), strip_order.end(), 0);
+    stable_sort(strip_order.begin(), strip_order.end(), [&](int a, int b) {
+        return data.strip_types_[strip_ids[a]].width_ < data.strip_types_[strip_ids[b]].width_;
+    });
+    vector<int> item_order(num_item_types);
+    iota(item_order.begin(), item_order.end(), 0);
+    stable_sort(item_order.begin(), item_order.end(), [&](int a, int b) {
+        return data.item_types_[a].width_ < data.item_types_[b].width_;
+    });
+
+    int widest = strip_ids[strip_order.back()];
+    LOG_FMT("[SP2-%d] 嵌套DP求解 %d 种条带类型\n", node.iter_, num_strips);
+
+    KnapsackDP& kp = GetPricingWorkspace(params).knapsack_dp_;
+    BeginNestedDP(kp, GetSP2Raster(data, params, widest), num_item_types);
+
+    int next_item = 0;
+    for (int s : strip_order) {
+        int j = strip_ids[s];
+        int strip_width = data.strip_types_[j].width_;
+
+        // 加入新允许的子件
+        while (next_item < num_item_types &&
+            data.item_types_[item_order[next_item]].width_ <= strip_width) {
+            int i = item_order[next_item++];
+            kp.sizes_[i] = data.item_types_[i].length_;
+            kp.values_[i] = node.duals_[num_strip_types + i];
+            kp.bounds_[i] = ItemCountBound(params, data, i);
+            AddNestedDPItem(kp, i);
+        }
+
+        double dual_v = node.duals_[j];
+        double rc = ReadNestedDP(kp);
+        node.sp2_bounds_[j] = rc;
+        LOG_FMT("  [SP2] 条带类型%d Reduced Cost: %.4f (v_j=%.4f)\n", j, rc - dual_v, dual_v);
+
+        if (rc > dual_v + kRcTolerance) {
+            ExtractDPPatterns(params, kp, dual_v + kRcTolerance, patterns[s]);
+            LOG_FMT("  [SP2] 找到改进列 %d 个\n", (int)patterns[s].size());
+        }
+    }
+}
@@ -0,0 +1,247 @@
+// =============================================================================
+// pricing_cache.cpp - SP2定价缓存 (以量化后的子件对偶价格为键复用精确求解结果)
+//                     与SP2上界跳过 (上界不超过v_j的条带类型免去精确求解)
+// =============================================================================
+
+#include "2DBP.h"
+
+#include <cstring>
+
+using namespace std;
+
+// 为每种条带类型分配一个空缓存 (并行定价前调用, 此后各线程只访问自己条带类型的缓存)
+void InitPricingCache(ProblemParams& params) {
+    params.pricing_caches_.assign(params.num_strip_types_, PricingCache());
+}
+
+// 条带类型strip_type_id的SP2子件价值: 宽度匹配且对偶价格为正的取mu_i, 其余为0
+// (非正价值的子件不会出现在最优方案中, 截断后不改变SP2最优值)
+static void ComputeSP2Values(ProblemParams& params, ProblemData& data, BPNode& node,
+    int strip_type_id, vector<double>& values) {
+
+    int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
+    int strip_width = data.strip_types_[strip_type_id].width_;
+
+    values.assign(num_item_types, 0.0);
+    for (int i = 0; i < num_item_types; i++) {
+        double dual = node.duals_[num_strip_types + i];
+        if (data.item_types_[i].width_ <= strip_width && dual > 0) {
+            values[i] = dual;
+        }
+    }
+}
+
+// 子件i在一根条带中的最大件数 (长度与需求上界取小)
+static int MaxItemCount(ProblemParams& params, ProblemData& data, int item_type_id) {
+    int max_count = params.stock_length_ / data.item_types_[item_type_id].length_;
+    return min(max_count, ItemCountBound(params, data, item_type_id));
+}
+
+// 价值由ref_values变为values后, 任一方案价值的最大增量: sum_i max(0, 增量) * 最大件数
+static double ValueIncreaseBound(ProblemParams& params, ProblemData& data,
+    const vector<double>& values, const vector<double>& ref_values) {
+
+    double increase = 0.0;
+    for (int i = 0; i < (int)values.size(); i++) {
+        double diff = values[i] - ref_values[i];
+        if (diff > 0) {
+            increase += diff * MaxItemCount(params, data, i);
+        }
+    }
+    return increase;
+}
+
+// 缓存键: 精确模式取价值的位模式, 量化模式取按步长取整后的格点编号
+static uint64_t BuildCacheKey(ProblemParams& params, const vector<double>& values,
+    vector<int64_t>& key) {
+
+    double quantum = params.pricing_cache_quantum_;
+
+    key.assign(values.size(), 0);
+    uint64_t hash = 14695981039346656037ULL;        // FNV-1a
+    for (int i = 0; i < (int)values.size(); i++) {
+        if (quantum > 0) {
+            key[i] = llround(values[i] / quantum);
+        } else {
+            memcpy(&key[i], &values[i], sizeof(int64_t));
+        }
+        hash = (hash ^ static_cast<uint64_t>(key[i])) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// 查询定价缓存
+// 缓存中的改进方案按当前价值重新计价, 仍为改进列的直接加入node.new_x_cols_;
+// 最优值上界加上价值变化引起的误差 (sum_i max(0, 价值增量) * 子件最大件数) 后仍不超过v_j时判定收敛
+// 精确模式下价值完全相同, 误差为0
+// 返回: true=命中 (cg_converged为结果), false=未命中, 需调用精确方法
+bool LookupPricingCache(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, bool& cg_converged) {
+
+    if (!params.pricing_cache_ || params.pricing_caches_.empty()) {
+        return false;
+    }
+
+    PricingCache& cache = params.pricing_caches_[strip_type_id];
+    cache.num_lookups_++;
+
+    vector<double> values;
+    vector<int64_t> key;
+    ComputeSP2Values(params, data, node, strip_type_id, values);
+    uint64_t hash = BuildCacheKey(params, values, key);
+    auto it = cache.index_.find(hash);
+    if (it == cache.index_.end()) {
+        return false;
+    }
+    const PricingCacheEntry& entry = cache.entries_[it->second];
+    if (entry.key_ != key) {
+        return false;  // 哈希冲突
+    }
+
+    int num_item_types = params.num_item_types_;
+    double bound = entry.bound_ + ValueIncreaseBound(params, data, values, entry.values_);
+    double dual_v = node.duals_[strip_type_id];
+
+    int num_found = 0;
+    for (const vector<int>& pattern : entry.patterns_) {
+        double value = 0.0;
+        for (int i = 0; i < num_item_types; i++) {
+            value += values[i] * pattern[i];
+        }
+        if (value > dual_v + kRcTolerance) {
+            XColumn x_col;
+            x_col.strip_type_id_ = strip_type_id;
+            x_col.pattern_ = pattern;
+            node.new_x_cols_.push_back(x_col);
+            num_found++;
+        }
+    }
+
+    if (num_found > 0) {
+        cg_converged = false;
+    } else if (bound <= dual_v + kRcTolerance) {
+        cg_converged = true;
+    } else {
+        return false;  // 缓存结果不足以判定, 需重新求解
+    }
+
+    node.sp2_bounds_[strip_type_id] = bound;
+    cache.num_hits_++;
+    LOG_FMT("[SP2-%d] 条带类型%d 命中定价缓存 (改进列 %d 个)\n",
+        node.iter_, strip_type_id, num_found);
+    return true;
+}
+
+// 记录一次精确求解的结果: node.new_x_cols_中first_col之后的列与SP2最优值上界
+void StorePricingCache(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id, int first_col) {
+
+    if (!params.pricing_cache_ || params.pricing_caches_.empty()) {
+        return;
+    }
+
+    PricingCache& cache = params.pricing_caches_[strip_type_id];
+
+    PricingCacheEntry entry;
+    ComputeSP2Values(params, data, node, strip_type_id, entry.values_);
+    entry.hash_ = BuildCacheKey(params, entry.values_, entry.key_);
+    entry.bound_ = node.sp2_bounds_[strip_type_id];
+    for (int k = first_col; k < (int)node.new_x_cols_.size(); k++) {
+        entry.patterns_.push_back(node.new_x_cols_[k].pattern_);
+    }
+
+    // 同键 (或哈希冲突) 的条目直接覆盖, 否则占用新位置或替换最早的条目
+    int slot;
+    auto it = cache.index_.find(entry.hash_);
+    if (it != cache.index_.end()) {
+        slot = it->second;
+    } else if ((int)cache.entries_.size() < max(1, params.pricing_cache_size_)) {
+        slot = static_cast<int>(cache.entries_.size());
+        cache.entries_.emplace_back();
+    } else {
+        slot = cache.next_slot_;
+        cache.next_slot_ = (slot + 1) % static_cast<int>(cache.entries_.size());
+        cache.index_.erase(cache.entries_[slot].hash_);
+    }
+
+    cache.index_[entry.hash_] = slot;
+    cache.entries_[slot] = move(entry);
+}
+
+// SP2的LP松弛上界: 按价值密度降序连续装填, 各子件件数不超过最大件数
+// 不限数量时即为 L * max(mu_i / l_i)
+static double SP2LPBound(ProblemParams& params, ProblemData& data,
+    const vector<double>& values) {
+
+    vector<int> order;
+    for (int i = 0; i < (int)values.size(); i++) {
+        if (values[i] > 0) {
+            order.push_back(i);
+        }
+    }
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        return values[a] * data.item_types_[b].length_ > values[b] * data.item_types_[a].length_;
+    });
+
+    double remaining = params.stock_length_;
+    double bound = 0.0;
+    for (int i : order) {
+        int length = data.item_types_[i].length_;
+        double take = min(remaining, static_cast<double>(MaxItemCount(params, data, i)) * length);
+        bound += take * values[i] / length;
+        remaining -= take;
+        if (remaining <= 0) break;
+    }
+    return bound;
+}
+
+// SP2上界检查: LP松弛上界与上次精确求解的上界 (加上价值增量) 取小
+// 上界不超过v_j + kRcTolerance时该条带类型不可能有改进列, 直接判定收敛
+// 返回: true=跳过精确求解 (已写入node.sp2_bounds_), false=需要求解
+bool SkipSP2ByBound(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id) {
+
+    if (!params.sp2_bound_skip_ || params.pricing_caches_.empty()) {
+        return false;
+    }
+
+    PricingCache& cache = params.pricing_caches_[strip_type_id];
+    double threshold = node.duals_[strip_type_id] + kRcTolerance;
+
+    vector<double> values;
+    ComputeSP2Values(params, data, node, strip_type_id, values);
+
+    double lp_bound = SP2LPBound(params, data, values);
+    double last_bound = INFINITY;
+    if (!cache.last_values_.empty() && cache.last_bound_ < INFINITY) {
+        last_bound = cache.last_bound_
+            + ValueIncreaseBound(params, data, values, cache.last_values_);
+    }
+
+    if (lp_bound <= threshold) {
+        cache.num_lp_skips_++;
+    } else if (last_bound <= threshold) {
+        cache.num_last_skips_++;
+    } else {
+        return false;
+    }
+
+    node.sp2_bounds_[strip_type_id] = min(lp_bound, last_bound);
+    LOG_FMT("[SP2-%d] 条带类型%d 上界%.4f不超过v_j=%.4f, 跳过\n",
+        node.iter_, strip_type_id, min(lp_bound, last_bound), node.duals_[strip_type_id]);
+    return true;
+}
+
+// 记录一次精确求解的子件价值与最优值上界, 供下次上界检查使用
+void RecordSP2Bound(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id) {
+
+    if (!params.sp2_bound_skip_ || params.pricing_caches_.empty()) {
+        return;
+    }
+
+    PricingCache& cache = params.pricing_caches_[strip_type_id];
+    ComputeSP2Values(params, data, node, strip_type_id, cache.last_values_);
+    cache.last_bound_ = node.sp2_bounds_[strip_type_id];
+}
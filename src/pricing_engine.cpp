@@ -0,0 +1,444 @@
+// =============================================================================
+// pricing_engine.cpp - 定价引擎 (SP1/SP2 x 根节点/非根节点 x 求解方法的统一实现)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// 上下文策略: 根节点输出完整日志, 非根节点只输出求解方法一行
+// -----------------------------------------------------------------------------
+
+struct RootContext {
+    static constexpr bool kVerbose = true;
+};
+
+struct NodeContext {
+    static constexpr bool kVerbose = false;
+};
+
+// -----------------------------------------------------------------------------
+// 子问题侧: 物品、容量、价值与改进列的去向
+// -----------------------------------------------------------------------------
+
+// SP1: 宽度背包 - 物品为条带类型, 价值为v_j, 容量为母板宽度W
+struct SP1Side {
+    static constexpr const char* kTag = "SP1";
+
+    int NumItems(ProblemParams& params) const {
+        return params.num_strip_types_;
+    }
+    int Size(ProblemData& data, int j) const {
+        return data.strip_types_[j].width_;
+    }
+    int Bound(ProblemParams& params, ProblemData& data, int j) const {
+        return StripCountBound(params, data, j);
+    }
+    int Capacity(ProblemParams& params) const {
+        return params.stock_width_;
+    }
+    const RasterPoints& Raster(ProblemParams& params, ProblemData& data) const {
+        return GetSP1Raster(data, params);
+    }
+
+    // 物品价值 v_j (非正价值的条带类型不会出现在最优方案中)
+    // 返回: 是否存在正价值物品
+    bool FillValues(ProblemParams& params, ProblemData&, BPNode& node,
+        vector<double>& values) const {
+
+        int num_strip_types = params.num_strip_types_;
+        values.assign(node.duals_.begin(), node.duals_.begin() + num_strip_types);
+        return any_of(values.begin(), values.end(), [](double v) { return v > 0; });
+    }
+
+    // 改进阈值: 方案价值超过1 (Y列的目标系数) 即为改进列
+    double Threshold(BPNode&) const {
+        return 1 + kRcTolerance;
+    }
+    void SetBound(BPNode&, double) const {}
+
+    void AddColumn(BPNode& node, const vector<int>& pattern) const {
+        YColumn y_col;
+        y_col.pattern_ = pattern;
+        node.new_y_cols_.push_back(y_col);
+    }
+
+    void LogHeader(BPNode& node, const char* method) const {
+        LOG_FMT("[SP1-%d] 节点%d 求解SP1 (%s)\n", node.iter_, node.id_, method);
+    }
+    void LogReducedCost(BPNode&, double rc) const {
+        LOG_FMT("  [SP1] Reduced Cost: %.4f\n", rc);
+    }
+
+#ifndef CS_NO_CPLEX
+    bool PrepareArcs(ProblemParams&, ProblemData& data) const {
+        return !data.sp1_arc_data_.arc_tail_.empty();
+    }
+    CplexSPModel& KnapsackModel(ProblemParams& params, ProblemData& data) const {
+        return GetSP1KnapsackModel(params, data);
+    }
+    CplexSPModel& ArcFlowModel(ProblemParams& params, ProblemData& data) const {
+        return GetSP1ArcFlowModel(params, data);
+    }
+#endif
+};
+
+// SP2: 长度背包 - 物品为宽度不超过条带的子件类型, 价值为mu_i, 容量为母板长度L
+struct SP2Side {
+    static constexpr const char* kTag = "SP2";
+
+    int strip_type_id_;
+
+    int NumItems(ProblemParams& params) const {
+        return params.num_item_types_;
+    }
+    int Size(ProblemData& data, int i) const {
+        return data.item_types_[i].length_;
+    }
+    int Bound(ProblemParams& params, ProblemData& data, int i) const {
+        return ItemCountBound(params, data, i);
+    }
+    int Capacity(ProblemParams& params) const {
+        return params.stock_length_;
+    }
+    const RasterPoints& Raster(ProblemParams& params, ProblemData& data) const {
+        return GetSP2Raster(data, params, strip_type_id_);
+    }
+
+    // 物品价值: 宽度匹配且对偶价格为正的取mu_i, 其余为0
+    // 返回: 是否存在正价值物品
+    bool FillValues(ProblemParams& params, ProblemData& data, BPNode& node,
+        vector<double>& values) const {
+
+        int num_item_types = params.num_item_types_;
+        int num_strip_types = params.num_strip_types_;
+        int strip_width = data.strip_types_[strip_type_id_].width_;
+
+        bool any_positive = false;
+        values.assign(num_item_types, 0.0);
+        for (int i = 0; i < num_item_types; i++) {
+            double dual = node.duals_[num_strip_types + i];
+            if (data.item_types_[i].width_ <= strip_width && dual > 0) {
+                values[i] = dual;
+                any_positive = true;
+            }
+        }
+        return any_positive;
+    }
+
+    // 改进阈值: 方案价值超过v_j (X列在条带行上的系数) 即为改进列
+    double Threshold(BPNode& node) const {
+        return node.duals_[strip_type_id_] + kRcTolerance;
+    }
+    void SetBound(BPNode& node, double bound) const {
+        node.sp2_bounds_[strip_type_id_] = bound;
+    }
+
+    void AddColumn(BPNode& node, const vector<int>& pattern) const {
+        XColumn x_col;
+        x_col.strip_type_id_ = strip_type_id_;
+        x_col.pattern_ = pattern;
+        node.new_x_cols_.push_back(x_col);
+    }
+
+    void LogHeader(BPNode& node, const char* method) const {
+        LOG_FMT("[SP2-%d] 条带类型%d 求解SP2 (%s)\n", node.iter_, strip_type_id_, method);
+    }
+    void LogReducedCost(BPNode& node, double rc) const {
+        double dual_v = node.duals_[strip_type_id_];
+        LOG_FMT("  [SP2] Reduced Cost: %.4f (v_j=%.4f)\n", rc - dual_v, dual_v);
+    }
+
+#ifndef CS_NO_CPLEX
+    // Arc网络按需生成
+    bool PrepareArcs(ProblemParams& params, ProblemData& data) const {
+        if ((int)data.sp2_arc_data_.size() <= strip_type_id_) {
+            GenerateSP2Arcs(data, params, strip_type_id_);
+        }
+        return !data.sp2_arc_data_[strip_type_id_].arc_tail_.empty();
+    }
+    CplexSPModel& KnapsackModel(ProblemParams& params, ProblemData& data) const {
+        return GetSP2KnapsackModel(params, data, strip_type_id_);
+    }
+    CplexSPModel& ArcFlowModel(ProblemParams& params, ProblemData& data) const {
+        return GetSP2ArcFlowModel(params, data, strip_type_id_);
+    }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+// 求解方法 (以子问题侧和上下文为模板参数, 每种组合编译为独立的函数)
+// -----------------------------------------------------------------------------
+
+// 加入改进列并输出结果
+// 返回: true=列生成收敛, false=找到改进列
+template <class Side, class Context>
+static bool FinishPricing(const Side& side, BPNode& node, double rc,
+    vector<vector<int>>& patterns) {
+
+    if constexpr (Context::kVerbose) {
+        side.LogReducedCost(node, rc);
+    }
+    if (patterns.empty()) {
+        if constexpr (Context::kVerbose) {
+            LOG_FMT("  [%s] 收敛\n", Side::kTag);
+        }
+        return true;
+    }
+
+    for (auto& pattern : patterns) {
+        side.AddColumn(node, pattern);
+    }
+    if constexpr (Context::kVerbose) {
+        LOG_FMT("  [%s] 找到改进列 %d 个\n", Side::kTag, (int)patterns.size());
+    }
+    return false;
+}
+
+// 动态规划求解
+template <class Side, class Context>
+static bool SolveSPDP(ProblemParams& params, ProblemData& data, BPNode& node,
+    const Side& side, const vector<double>& values) {
+
+    side.LogHeader(node, "DP");
+
+    int num_items = side.NumItems(params);
+    KnapsackDP& kp = GetPricingWorkspace(params).knapsack_dp_;
+    PrepareKnapsackDP(kp, num_items);
+    for (int k = 0; k < num_items; k++) {
+        if (values[k] <= 0) continue;
+
+        kp.sizes_[k] = side.Size(data, k);
+        kp.values_[k] = values[k];
+        kp.bounds_[k] = side.Bound(params, data, k);
+    }
+
+    double threshold = side.Threshold(node);
+    double rc = SolveKnapsackDP(params, kp, side.Raster(params, data), threshold);
+    side.SetBound(node, rc);
+
+    vector<vector<int>> patterns;
+    if (rc > threshold) {
+        ExtractDPPatterns(params, kp, threshold, patterns);
+    }
+    return FinishPricing<Side, Context>(side, node, rc, patterns);
+}
+
+// 分支定界求解 (搜索节点数超限时回退DP)
+template <class Side, class Context>
+static bool SolveSPBB(ProblemParams& params, ProblemData& data, BPNode& node,
+    const Side& side, const vector<double>& values) {
+
+    side.LogHeader(node, "B&B");
+
+    int num_items = side.NumItems(params);
+    KnapsackBB& kb = GetPricingWorkspace(params).knapsack_bb_;
+    PrepareKnapsackBB(kb, num_items);
+    for (int k = 0; k < num_items; k++) {
+        if (values[k] <= 0) continue;
+
+        kb.sizes_[k] = side.Size(data, k);
+        kb.values_[k] = values[k];
+        kb.bounds_[k] = side.Bound(params, data, k);
+    }
+
+    double rc = 0.0;
+    vector<vector<int>> patterns;
+    if (!SolveKnapsackBB(params, kb, side.Capacity(params), side.Threshold(node),
+        rc, patterns)) {
+        if constexpr (Context::kVerbose) {
+            LOG_FMT("  [%s] 分支定界节点数超限, 改用DP\n", Side::kTag);
+        }
+        return SolveSPDP<Side, Context>(params, data, node, side, values);
+    }
+    side.SetBound(node, rc);
+    if constexpr (Context::kVerbose) {
+        LOG_FMT("  [%s] 搜索节点 %lld\n", Side::kTag, kb.num_nodes_);
+    }
+    return FinishPricing<Side, Context>(side, node, rc, patterns);
+}
+
+#ifndef CS_NO_CPLEX
+// CPLEX求解常驻模型 (背包或Arc Flow), 从解池提取改进方案
+// 模型变量按var_types_计入方案: 背包模型每个变量为一种物品的件数, Arc Flow模型每个选中的 (Arc, 物品) 变量为一件
+template <class Side, class Context>
+static bool SolveSPCplex(ProblemParams& params, BPNode& node, const Side& side,
+    const vector<double>& values, CplexSPModel& sp, bool is_arc_flow) {
+
+    side.LogHeader(node, is_arc_flow ? "Arc Flow" : "背包");
+
+    // 常驻模型只更新目标系数
+    SetSPObjective(sp, values);
+    IloCplex& cplex = sp.cplex_;
+    if (!SolveSPModel(params, cplex)) {
+        if constexpr (Context::kVerbose) {
+            LOG_FMT("  [%s] 子问题不可行\n", Side::kTag);
+        }
+        return true;
+    }
+
+    double rc = cplex.getObjValue();
+    side.SetBound(node, cplex.getBestObjValue());
+
+    double threshold = side.Threshold(node);
+    int num_items = side.NumItems(params);
+    int num_vars = static_cast<int>(sp.var_types_.size());
+
+    // 不同解可能对应同一方案, 去重
+    vector<vector<int>> patterns;
+    if (rc > threshold) {
+        set<vector<int>> seen;
+        for (int soln : CollectImprovingSolutions(params, cplex, threshold)) {
+            if ((int)seen.size() >= params.max_cols_per_sp_) break;
+
+            vector<int> pattern(num_items, 0);
+            for (int v = 0; v < num_vars; v++) {
+                int type = sp.var_types_[v];
+                if (type < 0) continue;
+
+                double val = cplex.getValue(sp.vars_[v], soln);
+                if (is_arc_flow) {
+                    if (val > 0.5) pattern[type]++;
+                } else {
+                    pattern[type] += (val - (int)val > 0.99999) ? (int)val + 1 : (int)val;
+                }
+            }
+            if (seen.insert(pattern).second) {
+                patterns.push_back(pattern);
+            }
+        }
+    }
+    return FinishPricing<Side, Context>(side, node, rc, patterns);
+}
+#endif  // CS_NO_CPLEX
+
+// 按设置的求解方法求解 (无CPLEX构建时CPLEX类方法改用DP)
+// 无正价值物品时最优值为0, 不调用求解方法
+template <class Side, class Context>
+static bool SolveSPExact(ProblemParams& params, ProblemData& data, BPNode& node,
+    const Side& side, int method) {
+
+    vector<double> values;
+    if (!side.FillValues(params, data, node, values)) {
+        side.SetBound(node, 0);
+        return true;
+    }
+
+    switch (method) {
+        case kDP:
+            return SolveSPDP<Side, Context>(params, data, node, side, values);
+        case kBranchBound:
+            return SolveSPBB<Side, Context>(params, data, node, side, values);
+#ifndef CS_NO_CPLEX
+        case kArcFlow:
+            // 无可用Arc, 视为收敛
+            if (!side.PrepareArcs(params, data)) {
+                side.SetBound(node, 0);
+                return true;
+            }
+            return SolveSPCplex<Side, Context>(params, node, side, values,
+                side.ArcFlowModel(params, data), true);
+        case kCplexIP:
+        default:
+            return SolveSPCplex<Side, Context>(params, node, side, values,
+                side.KnapsackModel(params, data), false);
+#else
+        default:
+            return SolveSPDP<Side, Context>(params, data, node, side, values);
+#endif
+    }
+}
+
+// 按设置的求解方法求子问题最优值的上界 (不加入列, 用于拉格朗日下界)
+// 大于threshold时为精确最优值; 不超过threshold时只需证明这一点,
+// 分支定界与定点DP据此提前结束. CPLEX取最优值上界 (best bound), 求解失败时改用DP
+template <class Side>
+static double SolveSPValue(ProblemParams& params, ProblemData& data, const Side& side,
+    const vector<double>& values, int method, double threshold) {
+
+    int num_items = side.NumItems(params);
+    if (method == kBranchBound) {
+        KnapsackBB& kb = GetPricingWorkspace(params).knapsack_bb_;
+        PrepareKnapsackBB(kb, num_items);
+        for (int k = 0; k < num_items; k++) {
+            if (values[k] <= 0) continue;
+
+            kb.sizes_[k] = side.Size(data, k);
+            kb.values_[k] = values[k];
+            kb.bounds_[k] = side.Bound(params, data, k);
+        }
+
+        double val = 0.0;
+        vector<vector<int>> patterns;
+        if (SolveKnapsackBB(params, kb, side.Capacity(params), threshold, val, patterns)) {
+            return val;
+        }
+    }
+#ifndef CS_NO_CPLEX
+    if (method == kCplexIP || method == kArcFlow) {
+        if (method == kArcFlow && !side.PrepareArcs(params, data)) {
+            return 0.0;
+        }
+        CplexSPModel& sp = (method == kArcFlow) ?
+            side.ArcFlowModel(params, data) : side.KnapsackModel(params, data);
+        SetSPObjective(sp, values);
+        if (sp.cplex_.solve()) {
+            return sp.cplex_.getBestObjValue();
+        }
+    }
+#endif
+
+    KnapsackDP& kp = GetPricingWorkspace(params).knapsack_dp_;
+    PrepareKnapsackDP(kp, num_items);
+    for (int k = 0; k < num_items; k++) {
+        if (values[k] <= 0) continue;
+
+        kp.sizes_[k] = side.Size(data, k);
+        kp.values_[k] = values[k];
+        kp.bounds_[k] = side.Bound(params, data, k);
+    }
+    return SolveKnapsackDP(params, kp, side.Raster(params, data), threshold);
+}
+
+// -----------------------------------------------------------------------------
+// 对外接口
+// -----------------------------------------------------------------------------
+
+// 根节点SP1精确求解
+bool SolveRootSP1Exact(ProblemParams& params, ProblemData& data, BPNode& node) {
+    return SolveSPExact<SP1Side, RootContext>(params, data, node, SP1Side(),
+        node.sp1_method_);
+}
+
+// 非根节点SP1精确求解
+bool SolveNodeSP1Exact(ProblemParams& params, ProblemData& data, BPNode* node) {
+    return SolveSPExact<SP1Side, NodeContext>(params, data, *node, SP1Side(),
+        node->sp1_method_);
+}
+
+// 根节点SP2精确求解
+bool SolveRootSP2Exact(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id) {
+
+    return SolveSPExact<SP2Side, RootContext>(params, data, node, SP2Side{strip_type_id},
+        node.sp2_method_);
+}
+
+// 非根节点SP2精确求解
+bool SolveNodeSP2Exact(ProblemParams& params, ProblemData& data,
+    BPNode* node, int strip_type_id) {
+
+    return SolveSPExact<SP2Side, NodeContext>(params, data, *node, SP2Side{strip_type_id},
+        node->sp2_method_);
+}
+
+// 以给定条带价值求SP1最优值的上界 (按节点的SP1求解方法)
+double SolveSP1Value(ProblemParams& params, ProblemData& data, BPNode& node,
+    const vector<double>& strip_values, double threshold) {
+
+    if (none_of(strip_values.begin(), strip_values.end(), [](double v) { return v > 0; })) {
+        return 0.0;
+    }
+    return SolveSPValue(params, data, SP1Side(), strip_values, node.sp1_method_, threshold);
+}
@@ -0,0 +1,121 @@
+// =============================================================================
+// pricing_heuristic.cpp - SP2启发式定价 (贪心背包, 找不到改进列时由精确方法求解)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 按给定顺序贪心装填: 每个物品放入尽可能多的件数 (不超过数量上限)
+// 返回: 方案价值
+static double GreedyFill(const vector<int>& sizes, const vector<double>& values,
+    const vector<int>& bounds, int capacity, const vector<int>& order,
+    vector<int>& pattern) {
+
+    pattern.assign(sizes.size(), 0);
+    int remaining = capacity;
+    double total = 0.0;
+    for (int i : order) {
+        int count = min(bounds[i], remaining / sizes[i]);
+        if (count <= 0) continue;
+
+        pattern[i] = count;
+        remaining -= count * sizes[i];
+        total += count * values[i];
+    }
+    return total;
+}
+
+// 贪心背包启发式: 分别按价值密度降序与价值降序装填
+// 价值严格大于threshold的方案 (去重, 按价值降序, 至多max_cols_per_sp_个) 存入patterns
+static void GreedyKnapsack(ProblemParams& params, const vector<int>& sizes,
+    const vector<double>& values, const vector<int>& bounds, int capacity,
+    double threshold, vector<vector<int>>& patterns) {
+
+    patterns.clear();
+
+    vector<int> order;
+    for (int i = 0; i < (int)sizes.size(); i++) {
+        if (values[i] > 0 && sizes[i] > 0 && sizes[i] <= capacity && bounds[i] > 0) {
+            order.push_back(i);
+        }
+    }
+    if (order.empty()) {
+        return;
+    }
+
+    vector<pair<double, vector<int>>> found;
+    vector<int> pattern;
+
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return values[a] * sizes[b] > values[b] * sizes[a];
+    });
+    double val = GreedyFill(sizes, values, bounds, capacity, order, pattern);
+    if (val > threshold) {
+        found.push_back({val, pattern});
+    }
+
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return values[a] > values[b];
+    });
+    val = GreedyFill(sizes, values, bounds, capacity, order, pattern);
+    if (val > threshold && (found.empty() || found[0].second != pattern)) {
+        found.push_back({val, pattern});
+    }
+
+    stable_sort(found.begin(), found.end(),
+        [](const pair<double, vector<int>>& a, const pair<double, vector<int>>& b) {
+            return a.first > b.first;
+        });
+    int max_cols = max(1, params.max_cols_per_sp_);
+    for (auto& [v, p] : found) {
+        if ((int)patterns.size() >= max_cols) break;
+        patterns.push_back(move(p));
+    }
+}
+
+// SP2启发式定价: 宽度匹配的子件按对偶价格mu_i贪心装入条带长度
+// SP1每轮只有一个且规模小, 贪心Y列质量差会明显增加迭代次数, 因此只对SP2使用
+// 返回: 加入node.new_x_cols_的改进列数 (0=未找到, 需调用精确方法)
+int PriceSP2Heuristic(ProblemParams& params, ProblemData& data,
+    BPNode& node, int strip_type_id) {
+
+    if (!params.heuristic_pricing_) {
+        return 0;
+    }
+
+    int num_item_types = params.num_item_types_;
+    int num_strip_types = params.num_strip_types_;
+    int strip_width = data.strip_types_[strip_type_id].width_;
+
+    vector<int> sizes(num_item_types);
+    vector<double> values(num_item_types, 0.0);
+    vector<int> bounds(num_item_types);
+    for (int i = 0; i < num_item_types; i++) {
+        sizes[i] = data.item_types_[i].length_;
+        bounds[i] = ItemCountBound(params, data, i);
+        // 只考虑宽度匹配的子件
+        if (data.item_types_[i].width_ <= strip_width) {
+            values[i] = node.duals_[num_strip_types + i];
+        }
+    }
+
+    vector<vector<int>> patterns;
+    GreedyKnapsack(params, sizes, values, bounds, params.stock_length_,
+        node.duals_[strip_type_id] + kRcTolerance, patterns);
+    if (patterns.empty()) {
+        return 0;
+    }
+
+    for (auto& pattern : patterns) {
+        XColumn x_col;
+        x_col.strip_type_id_ = strip_type_id;
+        x_col.pattern_ = pattern;
+        node.new_x_cols_.push_back(x_col);
+    }
+    GetPricingWorkspace(params).num_heuristic_hits_++;
+    LOG_FMT("[SP2-%d] 条带类型%d 启发式找到改进列 %d 个\n",
+        node.iter_, strip_type_id, (int)patterns.size());
+
+    return static_cast<int>(patterns.size());
+}
@@ -0,0 +1,177 @@
+// =============================================================================
+// pricing_pool.cpp - 并行定价线程池 (各条带类型的SP2在同一组对偶价格下相互独立)
+// =============================================================================
+
+#include "2DBP.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+// 当前线程的工作区编号 (主线程为0, 线程池线程为1 ~ T-1)
+static thread_local int tls_worker_id = 0;
+
+// 常驻线程池: 主线程作为0号线程参与执行, 任务按编号动态领取
+// 任务结果由调用方按任务编号写入各自的位置, 合并顺序与线程调度无关
+class PricingPool {
+public:
+    explicit PricingPool(int num_threads);
+    ~PricingPool();
+
+    PricingPool(const PricingPool&) = delete;
+    PricingPool& operator=(const PricingPool&) = delete;
+
+    int NumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // 执行task(0) ~ task(num_tasks - 1), 全部完成后返回
+    // 任务抛出的第一个异常在主线程重新抛出
+    void Run(int num_tasks, const function<void(int)>& task);
+
+private:
+    void WorkerLoop(int worker_id);
+    void DrainTasks();
+
+    vector<thread> workers_;
+    mutex mutex_;
+    condition_variable start_cv_;           // 新一批任务或停止
+    condition_variable done_cv_;            // 线程池线程全部完成本批任务
+
+    const function<void(int)>* task_ = nullptr;
+    int num_tasks_ = 0;
+    atomic<int> next_task_{0};
+    int generation_ = 0;                    // 任务批次编号
+    int num_busy_ = 0;                      // 本批任务中尚未完成的线程池线程数
+    bool stop_ = false;
+    exception_ptr error_;
+};
+
+PricingPool::PricingPool(int num_threads) {
+    for (int t = 1; t < num_threads; t++) {
+        workers_.emplace_back(&PricingPool::WorkerLoop, this, t);
+    }
+}
+
+PricingPool::~PricingPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void PricingPool::DrainTasks() {
+    int t;
+    while ((t = next_task_.fetch_add(1)) < num_tasks_) {
+        try {
+            (*task_)(t);
+        } catch (...) {
+            lock_guard<mutex> lock(mutex_);
+            if (!error_) {
+                error_ = current_exception();
+            }
+        }
+    }
+}
+
+void PricingPool::WorkerLoop(int worker_id) {
+    tls_worker_id = worker_id;
+    int seen_generation = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        DrainTasks();
+
+        lock_guard<mutex> lock(mutex_);
+        if (--num_busy_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void PricingPool::Run(int num_tasks, const function<void(int)>& task) {
+    if (workers_.empty() || num_tasks <= 1) {
+        for (int t = 0; t < num_tasks; t++) {
+            task(t);
+        }
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(mutex_);
+        task_ = &task;
+        num_tasks_ = num_tasks;
+        next_task_ = 0;
+        num_busy_ = static_cast<int>(workers_.size());
+        error_ = nullptr;
+        generation_++;
+    }
+    start_cv_.notify_all();
+
+    DrainTasks();
+
+    exception_ptr error;
+    {
+        unique_lock<mutex> lock(mutex_);
+        done_cv_.wait(lock, [&] { return num_busy_ == 0; });
+        task_ = nullptr;
+        error = error_;
+    }
+    if (error) {
+        rethrow_exception(error);
+    }
+}
+
+static unique_ptr<PricingPool> pricing_pool;
+
+// 按params.num_pricing_threads_创建线程池并分配每个线程的工作区
+// 0表示使用全部硬件线程
+void InitPricingPool(ProblemParams& params) {
+    int num_threads = params.num_pricing_threads_;
+    if (num_threads <= 0) {
+        num_threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    }
+
+    pricing_pool.reset();
+    pricing_pool = make_unique<PricingPool>(num_threads);
+    params.workspaces_.resize(num_threads);
+
+    LOG_FMT("[定价] 并行定价线程数: %d\n", num_threads);
+}
+
+int GetNumPricingThreads() {
+    return pricing_pool ? pricing_pool->NumThreads() : 1;
+}
+
+// 当前线程的定价工作区
+PricingWorkspace& GetPricingWorkspace(ProblemParams& params) {
+    if (params.workspaces_.empty()) {
+        params.workspaces_.resize(1);
+    }
+    return params.workspaces_[tls_worker_id];
+}
+
+// 在线程池上执行一批相互独立的定价任务 (未初始化线程池时串行执行)
+void RunPricingTasks(int num_tasks, const function<void(int)>& task) {
+    if (!pricing_pool) {
+        for (int t = 0; t < num_tasks; t++) {
+            task(t);
+        }
+        return;
+    }
+    pricing_pool->Run(num_tasks, task);
+}
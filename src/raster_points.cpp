@@ -0,0 +1,179 @@
+// =============================================================================
+// raster_points.cpp - 可达位置预处理 (raster points, 供DP与Arc Flow共用)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 位集自或: bits |= bits << shift (高位字先更新, 读取的低位字仍为旧值)
+static void ShiftOrBits(vector<uint64_t>& bits, int shift) {
+    int num_words = static_cast<int>(bits.size());
+    int word_shift = shift / 64;
+    int bit_shift = shift % 64;
+
+    for (int w = num_words - 1; w >= word_shift; w--) {
+        int src = w - word_shift;
+        uint64_t val = bits[src] << bit_shift;
+        if (bit_shift != 0 && src > 0) {
+            val |= bits[src - 1] >> (64 - bit_shift);
+        }
+        bits[w] |= val;
+    }
+}
+
+// 稀疏生成可达位置 (缩放后): 按尺寸逐个求闭包 P <- {p + k * s},
+// 新集合由P与 (新集合 + s) 两个升序序列归并得到, 每个尺寸O(|P|), 与容量无关
+// 位置数超过max_points时放弃 (稠密情形位集更快), 返回false
+static bool ComputeSparsePoints(const vector<int>& scaled_sizes, int scaled_cap,
+    size_t max_points, vector<int>& points) {
+
+    points.assign(1, 0);
+    vector<int> next;
+    for (int s : scaled_sizes) {
+        next.clear();
+        size_t i = 0;
+        size_t k = 0;
+        while (true) {
+            long long from_old = (i < points.size()) ? points[i] : LLONG_MAX;
+            long long from_new = (k < next.size()) ? static_cast<long long>(next[k]) + s : LLONG_MAX;
+            long long pos = min(from_old, from_new);
+            if (pos > scaled_cap) break;
+
+            if (from_old == pos) i++;
+            if (from_new == pos) k++;
+            next.push_back(static_cast<int>(pos));
+            if (next.size() > max_points) {
+                return false;
+            }
+        }
+        swap(points, next);
+    }
+    return true;
+}
+
+// 位集生成可达位置 (缩放后): 对每个尺寸s依次左移s, 2s, 4s, ...,
+// 第k次后覆盖0 ~ 2^k-1个s的所有组合
+static void ComputeDensePoints(const vector<int>& scaled_sizes, int scaled_cap,
+    vector<int>& points) {
+
+    int num_bits = scaled_cap + 1;
+    vector<uint64_t> bits((num_bits + 63) / 64, 0);
+    bits[0] = 1;
+
+    for (int size : scaled_sizes) {
+        long long shift = size;
+        while (shift <= scaled_cap) {
+            ShiftOrBits(bits, static_cast<int>(shift));
+            shift *= 2;
+        }
+    }
+
+    // 清除超出容量的位
+    if (num_bits % 64 != 0) {
+        bits.back() &= (uint64_t(1) << (num_bits % 64)) - 1;
+    }
+
+    points.clear();
+    for (int q = 0; q < num_bits; q++) {
+        if ((bits[q / 64] >> (q % 64)) & 1) {
+            points.push_back(q);
+        }
+    }
+}
+
+// 计算尺寸集合sizes在容量capacity内的可达位置 (各尺寸可重复使用)
+// 先按最大公约数缩放; 可达位置稀疏时逐尺寸归并生成, 时间与内存只随位置数增长,
+// 位置数超过缩放后容量的1/kDenseRatio时改用位并行子集和
+void ComputeRasterPoints(const vector<int>& sizes, int capacity, RasterPoints& raster) {
+    constexpr int kDenseRatio = 16;
+
+    raster.capacity_ = capacity;
+    raster.gcd_ = 0;
+    for (int size : sizes) {
+        if (size > 0 && size <= capacity) {
+            raster.gcd_ = gcd(raster.gcd_, size);
+        }
+    }
+    if (raster.gcd_ == 0) {
+        raster.gcd_ = 1;
+    }
+
+    int gcd_val = raster.gcd_;
+    int scaled_cap = capacity / gcd_val;
+    vector<int> scaled_sizes;
+    for (int size : sizes) {
+        if (size > 0 && size <= capacity) {
+            scaled_sizes.push_back(size / gcd_val);
+        }
+    }
+    sort(scaled_sizes.begin(), scaled_sizes.end());
+    scaled_sizes.erase(unique(scaled_sizes.begin(), scaled_sizes.end()), scaled_sizes.end());
+
+    size_t max_points = static_cast<size_t>(scaled_cap / kDenseRatio) + 1024;
+    if (!ComputeSparsePoints(scaled_sizes, scaled_cap, max_points, raster.points_)) {
+        ComputeDensePoints(scaled_sizes, scaled_cap, raster.points_);
+    }
+    for (int& pos : raster.points_) {
+        pos *= gcd_val;
+    }
+}
+
+// 位置pos的可达位置下标, 不可达时返回-1
+int FindPoint(const RasterPoints& raster, int pos) {
+    const vector<int>& points = raster.points_;
+    auto it = lower_bound(points.begin(), points.end(), pos);
+    return (it != points.end() && *it == pos) ? static_cast<int>(it - points.begin()) : -1;
+}
+
+// 不超过pos的最大可达位置下标 (pos >= 0时至少为位置0)
+int FindFloorPoint(const RasterPoints& raster, int pos) {
+    const vector<int>& points = raster.points_;
+    int idx = static_cast<int>(upper_bound(points.begin(), points.end(), pos) - points.begin());
+    return idx - 1;
+}
+
+// 分配可达位置槽位 (不生成): 可达位置只在DP或Arc Flow首次使用时按需生成,
+// 分支定界与CPLEX方法不需要; SP2槽位须在并行定价前分配, 各任务只填充自己条带类型的槽位
+void InitRasterPoints(ProblemData& data, ProblemParams& params) {
+    data.sp1_raster_ = RasterPoints();
+    data.sp2_raster_.assign(params.num_strip_types_, RasterPoints());
+}
+
+// SP1的可达位置 (宽度方向, 物品为各条带类型宽度), 首次调用时生成
+const RasterPoints& GetSP1Raster(ProblemData& data, ProblemParams& params) {
+    RasterPoints& raster = data.sp1_raster_;
+    if (!raster.points_.empty()) {
+        return raster;
+    }
+
+    int num_strip_types = params.num_strip_types_;
+    vector<int> strip_widths(num_strip_types);
+    for (int j = 0; j < num_strip_types; j++) {
+        strip_widths[j] = data.strip_types_[j].width_;
+    }
+    ComputeRasterPoints(strip_widths, params.stock_width_, raster);
+    LOG_FMT("[Raster] SP1: 可达位置 %d / %d (gcd=%d)\n",
+        (int)raster.points_.size(), params.stock_width_ + 1, raster.gcd_);
+    return raster;
+}
+
+// 条带类型strip_type_id的SP2可达位置 (长度方向, 物品为宽度匹配的子件长度), 首次调用时生成
+const RasterPoints& GetSP2Raster(ProblemData& data, ProblemParams& params, int strip_type_id) {
+    RasterPoints& raster = data.sp2_raster_[strip_type_id];
+    if (!raster.points_.empty()) {
+        return raster;
+    }
+
+    int strip_width = data.strip_types_[strip_type_id].width_;
+    vector<int> item_lengths;
+    for (int i = 0; i < params.num_item_types_; i++) {
+        if (data.item_types_[i].width_ <= strip_width) {
+            item_lengths.push_back(data.item_types_[i].length_);
+        }
+    }
+    ComputeRasterPoints(item_lengths, params.stock_length_, raster);
+    LOG_FMT("[Raster] SP2-%d: 可达位置 %d / %d (gcd=%d)\n", strip_type_id + 1,
+        (int)raster.points_.size(), params.stock_length_ + 1, raster.gcd_);
+    return raster;
+}
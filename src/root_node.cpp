@@ -14,20 +14,21 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
     root_node.sp1_method_ = params.sp1_method_;
     root_node.sp2_method_ = params.sp2_method_;
 
-    // 初始化CPLEX环境
-    IloEnv env;
-    IloModel model(env);
-    IloObjective obj = IloAdd(model, IloMinimize(env));
-    IloNumVarArray vars(env);
-    IloRangeArray cons(env);
+    // 主问题LP在整个列生成过程中只建立一次
+    MasterLP mp;
 
     root_node.iter_ = 0;
+    InitDualStabilization(params, root_node);
+    root_node.lagrangian_bound_ = -INFINITY;
+    root_node.sp2_bounds_.assign(params.num_strip_types_, INFINITY);
+    auto cg_start = chrono::steady_clock::now();
 
     // 求解初始主问题
-    bool feasible = SolveRootInitMP(params, data, env, model, obj, cons, vars, root_node);
+    bool feasible = SolveRootInitMP(params, data, mp, root_node);
 
     if (feasible) {
         // 列生成主循环
+        bool cg_converged = false;
         while (true) {
             root_node.iter_++;
 
@@ -36,43 +37,68 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
                 break;
             }
 
-            // 求解子问题SP1 (宽度背包)
-            bool sp1_converged = SolveRootSP1(params, data, root_node);
+            if (params.pricing_mode_ != kSequentialPricing) {
+                // 批量定价: SP1与全部SP2使用同一组对偶价格求解,
+                // 本轮所有改进列一次性加入, 每轮只重解一次主问题
+                bool converged = SolvePricingRound(params, data, root_node, true);
 
-            if (sp1_converged) {
-                // SP1收敛, 尝试SP2
-                bool all_sp2_converged = true;
-
-                for (int j = 0; j < params.num_strip_types_; j++) {
-                    bool sp2_converged = SolveRootSP2(params, data, root_node, j);
-
-                    if (!sp2_converged) {
-                        all_sp2_converged = false;
-                        // 添加新X列
-                        SolveRootUpdateMP(params, data, env, model, obj, cons, vars, root_node);
-                    }
+                if (converged) {
+                    LOG_FMT("[CG] 列生成收敛, 迭代%d次\n", root_node.iter_);
+                    cg_converged = true;
+                    break;
                 }
 
-                if (all_sp2_converged) {
-                    LOG_FMT("[CG] 列生成收敛, 迭代%d次\n", root_node.iter_);
+                // 拉格朗日下界已足以确定节点结果时提前终止
+                int status = CheckLagrangianTermination(params, root_node);
+                if (status != 0) {
+                    root_node.new_y_cols_.clear();
+                    root_node.new_x_cols_.clear();
                     break;
                 }
+
+                SolveRootUpdateMP(params, data, mp, root_node);
             } else {
-                // SP1找到改进列, 添加新Y列
-                SolveRootUpdateMP(params, data, env, model, obj, cons, vars, root_node);
+                // 求解子问题SP1 (宽度背包)
+                bool sp1_converged = SolveRootSP1(params, data, root_node);
+
+                if (sp1_converged) {
+                    // SP1收敛, 尝试SP2
+                    bool all_sp2_converged = true;
+
+                    for (int j = 0; j < params.num_strip_types_; j++) {
+                        bool sp2_converged = SolveRootSP2(params, data, root_node, j);
+
+                        if (!sp2_converged) {
+                            all_sp2_converged = false;
+                            // 添加新X列
+                            SolveRootUpdateMP(params, data, mp, root_node);
+                        }
+                    }
+
+                    if (all_sp2_converged) {
+                        LOG_FMT("[CG] 列生成收敛, 迭代%d次\n", root_node.iter_);
+                        cg_converged = true;
+                        break;
+                    }
+                } else {
+                    // SP1找到改进列, 添加新Y列
+                    SolveRootUpdateMP(params, data, mp, root_node);
+                }
             }
         }
 
         // 求解最终主问题
-        SolveRootFinalMP(params, data, env, model, obj, cons, vars, root_node);
+        if (SolveRootFinalMP(params, data, mp, root_node)) {
+            UpdateNodeLowerBound(params, root_node, cg_converged);
+        }
     }
 
     // 释放CPLEX资源
-    obj.end();
-    vars.end();
-    cons.end();
-    model.end();
-    env.end();
+    EndMasterLP(mp);
+
+    double cg_time = chrono::duration<double>(chrono::steady_clock::now() - cg_start).count();
+    LOG_FMT("[CG] 迭代%d次, 耗时%.3f秒, 误定价%d次\n",
+        root_node.iter_, cg_time, root_node.mispricing_count_);
 
     LOG("[CG] 根节点列生成结束");
 }
@@ -83,217 +109,103 @@ void SolveRootCG(ProblemParams& params, ProblemData& data, BPNode& root_node) {
 //   s.t. sum(C_jk*y_k) - sum(x_p) >= 0   (条带平衡约束)
 //        sum(B_ip*x_p) >= d_i            (子件需求约束)
 bool SolveRootInitMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode& root_node) {
+    MasterLP& mp, BPNode& root_node) {
 
     int num_y_cols = static_cast<int>(root_node.y_columns_.size());
     int num_x_cols = static_cast<int>(root_node.x_columns_.size());
-    int num_strip_types = params.num_strip_types_;
-    int num_item_types = params.num_item_types_;
-    int num_rows = num_strip_types + num_item_types;
 
     LOG_FMT("[MP-0] 构建初始主问题 (Y=%d, X=%d)\n", num_y_cols, num_x_cols);
 
     // 构建约束
-    IloNumArray con_min(env);
-    IloNumArray con_max(env);
-
-    // 条带平衡约束: sum(C_jk*y_k) - sum(x_p) >= 0
-    for (int j = 0; j < num_strip_types; j++) {
-        con_min.add(0);
-        con_max.add(IloInfinity);
-    }
-
-    // 子件需求约束: sum(B_ip*x_p) >= d_i
-    for (int i = 0; i < num_item_types; i++) {
-        con_min.add(data.item_types_[i].demand_);
-        con_max.add(IloInfinity);
-    }
-
-    cons = IloRangeArray(env, con_min, con_max);
-    model.add(cons);
-    con_min.end();
-    con_max.end();
+    InitMasterLP(params, data, mp);
 
     // 添加Y变量 (目标系数=1)
     for (int col = 0; col < num_y_cols; col++) {
-        IloNumColumn cplex_col = obj(1.0);
-
-        // 条带产出部分
-        for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j](root_node.y_columns_[col].pattern_[j]);
-        }
-        // 子件产出部分 (0)
-        for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](0);
-        }
-
-        string var_name = "Y_" + to_string(col + 1);
-        IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
-        vars.add(var);
-        cplex_col.end();
+        AddYColumnToMP(params, mp, root_node.y_columns_[col].pattern_,
+            INFINITY, col + 1);
     }
 
     // 添加X变量 (目标系数=0)
     for (int col = 0; col < num_x_cols; col++) {
-        IloNumColumn cplex_col = obj(0.0);
-        int strip_type = root_node.x_columns_[col].strip_type_id_;
-
-        // 条带消耗部分 (-1在对应位置)
-        for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j]((j == strip_type) ? -1 : 0);
-        }
-        // 子件产出部分
-        for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](root_node.x_columns_[col].pattern_[i]);
-        }
-
-        string var_name = "X_" + to_string(col + 1);
-        IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
-        vars.add(var);
-        cplex_col.end();
+        AddXColumnToMP(params, mp, root_node.x_columns_[col].strip_type_id_,
+            root_node.x_columns_[col].pattern_, INFINITY, col + 1);
     }
 
     // 求解
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    bool feasible = SolveMasterLP(params, mp, root_node);
 
     if (!feasible) {
         LOG("[MP] 初始主问题不可行");
-        cplex.end();
         return false;
     }
 
-    double obj_val = cplex.getValue(obj);
-    LOG_FMT("[MP] 目标值: %.4f\n", obj_val);
-
-    // 提取对偶价格
-    root_node.duals_.clear();
-    for (int row = 0; row < num_rows; row++) {
-        double dual = cplex.getDual(cons[row]);
-        if (dual == -0.0) dual = 0.0;
-        root_node.duals_.push_back(dual);
-    }
-
-    cplex.end();
     return true;
 }
 
 // 更新主问题 (添加新列)
+// 新列增量加入持久模型, 不重新提取
 bool SolveRootUpdateMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode& node) {
+    MasterLP& mp, BPNode& node) {
 
-    int num_strip_types = params.num_strip_types_;
-    int num_item_types = params.num_item_types_;
+    int num_new_y = static_cast<int>(node.new_y_cols_.size());
+    int num_new_x = static_cast<int>(node.new_x_cols_.size());
 
     // 添加新Y列
-    if (!node.new_y_col_.pattern_.empty()) {
-        IloNumColumn cplex_col = obj(1.0);
-
-        for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j](node.new_y_col_.pattern_[j]);
-        }
-        for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](0);
-        }
-
+    for (YColumn& y_col : node.new_y_cols_) {
         int col_id = static_cast<int>(node.y_columns_.size()) + 1;
-        string var_name = "Y_" + to_string(col_id);
-        IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
-        vars.add(var);
-        cplex_col.end();
-
-        // 保存新列
-        YColumn y_col;
-        y_col.pattern_ = node.new_y_col_.pattern_;
-        y_col.arc_set_ = node.new_y_col_.arc_set_;
+        AddYColumnToMP(params, mp, y_col.pattern_, INFINITY, col_id);
         node.y_columns_.push_back(y_col);
-
-        node.new_y_col_.pattern_.clear();
-        node.new_y_col_.arc_set_.clear();
+        AddYColumnToPool(params, y_col);
     }
 
     // 添加新X列
-    if (!node.new_x_col_.pattern_.empty()) {
-        int strip_type = node.new_strip_type_;
-        IloNumColumn cplex_col = obj(0.0);
-
-        for (int j = 0; j < num_strip_types; j++) {
-            cplex_col += cons[j]((j == strip_type) ? -1 : 0);
-        }
-        for (int i = 0; i < num_item_types; i++) {
-            cplex_col += cons[num_strip_types + i](node.new_x_col_.pattern_[i]);
-        }
-
+    for (XColumn& x_col : node.new_x_cols_) {
         int col_id = static_cast<int>(node.x_columns_.size()) + 1;
-        string var_name = "X_" + to_string(col_id);
-        IloNumVar var(cplex_col, 0, IloInfinity, ILOFLOAT, var_name.c_str());
-        vars.add(var);
-        cplex_col.end();
-
-        // 保存新列
-        XColumn x_col;
-        x_col.strip_type_id_ = strip_type;
-        x_col.pattern_ = node.new_x_col_.pattern_;
-        x_col.arc_set_ = node.new_x_col_.arc_set_;
+        AddXColumnToMP(params, mp, x_col.strip_type_id_, x_col.pattern_,
+            INFINITY, col_id);
         node.x_columns_.push_back(x_col);
-
-        node.new_x_col_.pattern_.clear();
-        node.new_x_col_.arc_set_.clear();
+        AddXColumnToPool(params, x_col);
     }
 
-    // 求解更新后的主问题
-    LOG_FMT("[MP-%d] 更新并求解主问题\n", node.iter_);
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    node.new_y_cols_.clear();
+    node.new_x_cols_.clear();
+
+    // 求解更新后的主问题 (热启动)
+    LOG_FMT("[MP-%d] 更新并求解主问题 (新增Y=%d, X=%d)\n",
+        node.iter_, num_new_y, num_new_x);
+    bool feasible = SolveMasterLP(params, mp, node);
 
     if (!feasible) {
         LOG("[MP] 更新后主问题不可行");
-        cplex.end();
         return false;
     }
 
-    double obj_val = cplex.getValue(obj);
-    LOG_FMT("[MP] 目标值: %.4f\n", obj_val);
-
-    // 提取对偶价格
-    node.duals_.clear();
-    int num_rows = num_strip_types + num_item_types;
-    for (int row = 0; row < num_rows; row++) {
-        double dual = cplex.getDual(cons[row]);
-        if (dual == -0.0) dual = 0.0;
-        node.duals_.push_back(dual);
-    }
+    // 清除长期处于非基状态的列
+    ManageColumns(params, mp, node);
 
-    cplex.end();
     return true;
 }
 
 // 求解最终主问题
 bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
-    IloEnv& env, IloModel& model, IloObjective& obj,
-    IloRangeArray& cons, IloNumVarArray& vars, BPNode& node) {
+    MasterLP& mp, BPNode& node) {
 
     LOG_FMT("[MP-Final] 节点%d求解最终主问题\n", node.id_);
 
-    IloCplex cplex(env);
-    cplex.extract(model);
-    cplex.setOut(env.getNullStream());
-    bool feasible = cplex.solve();
+    // 最终解用于整数性判断与分支, 需要顶点解
+    mp.dual_mode_ = kVertexDuals;
+
+    bool feasible = SolveMasterLP(params, mp, node);
 
     if (!feasible) {
         LOG("[MP] 最终主问题不可行");
-        cplex.end();
         return false;
     }
 
-    double obj_val = cplex.getValue(obj);
-    node.lower_bound_ = obj_val;
+    // 保存最终基, 子节点从该基热启动
+    SaveMasterBasis(mp, node);
+
+    double obj_val = mp.obj_val_;
     node.solution_.obj_val_ = obj_val;
 
     LOG_FMT("[MP] 最终目标值: %.4f\n", obj_val);
@@ -301,7 +213,7 @@ bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
     // 提取Y列解值
     node.solution_.y_columns_.clear();
     for (int col = 0; col < (int)node.y_columns_.size(); col++) {
-        double val = cplex.getValue(vars[col]);
+        double val = mp.y_values_[col];
         if (fabs(val) < kZeroTolerance) val = 0;
 
         YColumn y_col = node.y_columns_[col];
@@ -315,9 +227,8 @@ bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
 
     // 提取X列解值
     node.solution_.x_columns_.clear();
-    int y_count = static_cast<int>(node.y_columns_.size());
     for (int col = 0; col < (int)node.x_columns_.size(); col++) {
-        double val = cplex.getValue(vars[y_count + col]);
+        double val = mp.x_values_[col];
         if (fabs(val) < kZeroTolerance) val = 0;
 
         XColumn x_col = node.x_columns_[col];
@@ -329,6 +240,5 @@ bool SolveRootFinalMP(ProblemParams& params, ProblemData& data,
         }
     }
 
-    cplex.end();
     return true;
 }
@@ -0,0 +1,650 @@
+// =============================================================================
+// simplex.cpp - 内置有界修正单纯形法 (主问题LP后端, 不依赖CPLEX)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+constexpr double kSimplexBigM = 1.0e6;          // 人工变量费用
+constexpr double kSimplexPivotTol = 1.0e-9;     // 主元容差
+constexpr double kSimplexOptTol = 1.0e-9;       // 对偶可行容差
+constexpr double kSimplexFeasTol = 1.0e-7;      // 原始可行容差
+constexpr int kSimplexRefactorInterval = 100;   // 重新分解间隔 (换基次数)
+constexpr int kSimplexBlandThreshold = 50;      // 连续退化换基次数达到后改用Bland规则
+constexpr int kSimplexMaxIter = 100000;         // 单次求解最大迭代次数
+
+// 变量类型判断 (编号规则见SimplexLP)
+static bool IsArtificial(SimplexLP& lp, int var) {
+    return var >= lp.num_rows_ && var < 2 * lp.num_rows_;
+}
+
+// 离基变量置为非基 (下界或上界), 人工变量离基后固定为0
+static void SetNonbasic(SimplexLP& lp, int var, bool at_upper) {
+    if (IsArtificial(lp, var)) {
+        lp.ubs_[var] = 0.0;
+        at_upper = false;
+    }
+    lp.status_[var] = at_upper ? kVarAtUpper : kVarAtLower;
+}
+
+// 由基变量列重新计算B^-1 (Gauss-Jordan, 部分选主元)
+// 返回: false=基矩阵奇异
+static bool RefactorBasis(SimplexLP& lp) {
+    int m = lp.num_rows_;
+
+    vector<double> mat(m * m, 0.0);
+    for (int r = 0; r < m; r++) {
+        for (auto& [row, coef] : lp.cols_[lp.basis_[r]]) {
+            mat[row * m + r] = coef;
+        }
+    }
+
+    lp.basis_inv_.assign(m * m, 0.0);
+    for (int r = 0; r < m; r++) {
+        lp.basis_inv_[r * m + r] = 1.0;
+    }
+
+    for (int c = 0; c < m; c++) {
+        int pivot = c;
+        for (int r = c + 1; r < m; r++) {
+            if (fabs(mat[r * m + c]) > fabs(mat[pivot * m + c])) {
+                pivot = r;
+            }
+        }
+        if (fabs(mat[pivot * m + c]) < kSimplexPivotTol) {
+            return false;
+        }
+        if (pivot != c) {
+            for (int k = 0; k < m; k++) {
+                swap(mat[pivot * m + k], mat[c * m + k]);
+                swap(lp.basis_inv_[pivot * m + k], lp.basis_inv_[c * m + k]);
+            }
+        }
+
+        double inv_pivot = 1.0 / mat[c * m + c];
+        for (int k = 0; k < m; k++) {
+            mat[c * m + k] *= inv_pivot;
+            lp.basis_inv_[c * m + k] *= inv_pivot;
+        }
+
+        for (int r = 0; r < m; r++) {
+            double factor = mat[r * m + c];
+            if (r == c || factor == 0.0) continue;
+            for (int k = 0; k < m; k++) {
+                mat[r * m + k] -= factor * mat[c * m + k];
+                lp.basis_inv_[r * m + k] -= factor * lp.basis_inv_[c * m + k];
+            }
+        }
+    }
+
+    lp.num_pivots_ = 0;
+    return true;
+}
+
+// 重置为人工变量初始基 (B = I)
+static void ResetBasis(SimplexLP& lp) {
+    int m = lp.num_rows_;
+    int num_vars = static_cast<int>(lp.cols_.size());
+
+    for (int var = 0; var < num_vars; var++) {
+        lp.status_[var] = kVarAtLower;
+    }
+    for (int r = 0; r < m; r++) {
+        lp.basis_[r] = m + r;
+        lp.ubs_[m + r] = INFINITY;
+        lp.status_[m + r] = kVarBasic;
+    }
+}
+
+// x_B = B^-1 * (b - sum(a_j * u_j)), 其中j为处于上界的非基变量
+static void ComputeBasicValues(SimplexLP& lp) {
+    int m = lp.num_rows_;
+    int num_vars = static_cast<int>(lp.cols_.size());
+
+    vector<double> residual = lp.rhs_;
+    for (int var = 0; var < num_vars; var++) {
+        if (lp.status_[var] != kVarAtUpper) continue;
+        for (auto& [row, coef] : lp.cols_[var]) {
+            residual[row] -= coef * lp.ubs_[var];
+        }
+    }
+
+    lp.x_basic_.assign(m, 0.0);
+    for (int r = 0; r < m; r++) {
+        double val = 0.0;
+        for (int i = 0; i < m; i++) {
+            val += lp.basis_inv_[r * m + i] * residual[i];
+        }
+        lp.x_basic_[r] = val;
+    }
+}
+
+// y' = c_B' * B^-1
+static void ComputeDuals(SimplexLP& lp) {
+    int m = lp.num_rows_;
+
+    lp.duals_.assign(m, 0.0);
+    for (int r = 0; r < m; r++) {
+        double cost = lp.costs_[lp.basis_[r]];
+        if (cost == 0.0) continue;
+        for (int i = 0; i < m; i++) {
+            lp.duals_[i] += cost * lp.basis_inv_[r * m + i];
+        }
+    }
+}
+
+// 检验数 d_j = c_j - y' * a_j
+static double ComputeReducedCost(SimplexLP& lp, int var) {
+    double rc = lp.costs_[var];
+    for (auto& [row, coef] : lp.cols_[var]) {
+        rc -= lp.duals_[row] * coef;
+    }
+    return rc;
+}
+
+// alpha = B^-1 * a_q
+static void ComputeColumn(SimplexLP& lp, int var, vector<double>& alpha) {
+    int m = lp.num_rows_;
+
+    alpha.assign(m, 0.0);
+    for (auto& [row, coef] : lp.cols_[var]) {
+        for (int r = 0; r < m; r++) {
+            alpha[r] += lp.basis_inv_[r * m + row] * coef;
+        }
+    }
+}
+
+// 换基: 变量enter在第leave_row行进基, 秩1更新B^-1
+static void Pivot(SimplexLP& lp, int leave_row, int enter, const vector<double>& alpha) {
+    int m = lp.num_rows_;
+
+    double* pivot_row = &lp.basis_inv_[leave_row * m];
+    double inv_pivot = 1.0 / alpha[leave_row];
+    for (int k = 0; k < m; k++) {
+        pivot_row[k] *= inv_pivot;
+    }
+    for (int r = 0; r < m; r++) {
+        if (r == leave_row || alpha[r] == 0.0) continue;
+        double factor = alpha[r];
+        double* row = &lp.basis_inv_[r * m];
+        for (int k = 0; k < m; k++) {
+            row[k] -= factor * pivot_row[k];
+        }
+    }
+
+    lp.basis_[leave_row] = enter;
+    lp.status_[enter] = kVarBasic;
+    lp.num_pivots_++;
+}
+
+// 原始单纯形迭代 (从当前原始可行基出发)
+// 返回: 0=最优, 1=无界, 2=达到迭代上限
+static int RunPrimalSimplex(SimplexLP& lp) {
+    int m = lp.num_rows_;
+    int num_vars = static_cast<int>(lp.cols_.size());
+    int degenerate_steps = 0;
+    vector<double> alpha;
+
+    for (int iter = 0; iter < kSimplexMaxIter; iter++) {
+        ComputeDuals(lp);
+
+        // 选择进基变量: Dantzig规则; 连续退化时改用Bland规则 (最小编号) 防止循环
+        bool use_bland = degenerate_steps >= kSimplexBlandThreshold;
+        int enter = -1;
+        int dir = 0;
+        double best_score = 0.0;
+        for (int var = 0; var < num_vars; var++) {
+            int status = lp.status_[var];
+            if (status == kVarBasic || lp.ubs_[var] <= 0.0) continue;
+
+            double rc = ComputeReducedCost(lp, var);
+            double score = 0.0;
+            int var_dir = 0;
+            if (status == kVarAtLower && rc < -kSimplexOptTol) {
+                score = -rc;
+                var_dir = 1;
+            } else if (status == kVarAtUpper && rc > kSimplexOptTol) {
+                score = rc;
+                var_dir = -1;
+            } else {
+                continue;
+            }
+
+            if (score > best_score) {
+                best_score = score;
+                enter = var;
+                dir = var_dir;
+                if (use_bland) break;
+            }
+        }
+
+        if (enter < 0) {
+            return 0;
+        }
+
+        // 比值检验: 进基变量沿dir方向移动t, 基变量变化 -dir*t*alpha
+        ComputeColumn(lp, enter, alpha);
+
+        double t_max = lp.ubs_[enter];
+        int leave_row = -1;
+        bool leave_to_upper = false;
+        for (int r = 0; r < m; r++) {
+            double delta = -dir * alpha[r];
+            int basic_var = lp.basis_[r];
+            double t = INFINITY;
+            bool to_upper = false;
+
+            if (delta < -kSimplexPivotTol) {
+                t = max(0.0, lp.x_basic_[r]) / -delta;
+            } else if (delta > kSimplexPivotTol && lp.ubs_[basic_var] < INFINITY) {
+                t = max(0.0, lp.ubs_[basic_var] - lp.x_basic_[r]) / delta;
+                to_upper = true;
+            } else {
+                continue;
+            }
+
+            // 并列时: 优先换基而非界限翻转; Bland规则下取最小编号, 否则取最大主元
+            bool take = false;
+            if (t < t_max - kSimplexPivotTol) {
+                take = true;
+            } else if (t <= t_max + kSimplexPivotTol) {
+                if (leave_row < 0) {
+                    take = true;
+                } else if (use_bland) {
+                    take = basic_var < lp.basis_[leave_row];
+                } else {
+                    take = fabs(alpha[r]) > fabs(alpha[leave_row]);
+                }
+            }
+            if (take) {
+                t_max = t;
+                leave_row = r;
+                leave_to_upper = to_upper;
+            }
+        }
+
+        if (t_max == INFINITY) {
+            return 1;
+        }
+
+        degenerate_steps = (t_max < kSimplexPivotTol) ? degenerate_steps + 1 : 0;
+
+        for (int r = 0; r < m; r++) {
+            lp.x_basic_[r] -= dir * t_max * alpha[r];
+        }
+
+        if (leave_row < 0) {
+            // 进基变量到达另一侧界限, 基不变
+            lp.status_[enter] = (dir > 0) ? kVarAtUpper : kVarAtLower;
+            continue;
+        }
+
+        int leave = lp.basis_[leave_row];
+        double enter_value = (dir > 0) ? t_max : lp.ubs_[enter] - t_max;
+
+        SetNonbasic(lp, leave, leave_to_upper);
+        Pivot(lp, leave_row, enter, alpha);
+        lp.x_basic_[leave_row] = enter_value;
+        lp.total_iters_++;
+
+        if (lp.num_pivots_ >= kSimplexRefactorInterval) {
+            if (!RefactorBasis(lp)) {
+                ResetBasis(lp);
+                RefactorBasis(lp);
+            }
+            ComputeBasicValues(lp);
+        }
+    }
+
+    return 2;
+}
+
+// 当前基是否原始可行
+static bool IsPrimalFeasible(SimplexLP& lp) {
+    for (int r = 0; r < lp.num_rows_; r++) {
+        double ub = lp.ubs_[lp.basis_[r]];
+        if (lp.x_basic_[r] < -kSimplexFeasTol || lp.x_basic_[r] > ub + kSimplexFeasTol) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 当前基是否对偶可行 (下界非基变量检验数>=0, 上界非基变量检验数<=0)
+static bool IsDualFeasible(SimplexLP& lp) {
+    int num_vars = static_cast<int>(lp.cols_.size());
+
+    ComputeDuals(lp);
+    for (int var = 0; var < num_vars; var++) {
+        int status = lp.status_[var];
+        if (status == kVarBasic || lp.ubs_[var] <= 0.0) continue;
+
+        double rc = ComputeReducedCost(lp, var);
+        if (status == kVarAtLower && rc < -kSimplexOptTol) return false;
+        if (status == kVarAtUpper && rc > kSimplexOptTol) return false;
+    }
+    return true;
+}
+
+// 对偶单纯形迭代 (从对偶可行、原始不可行的基出发, 如加入分支上界后的父节点最优基)
+// 返回: 0=达到原始可行 (即最优), 1=原问题不可行, 2=达到迭代上限
+static int RunDualSimplex(SimplexLP& lp) {
+    int m = lp.num_rows_;
+    int num_vars = static_cast<int>(lp.cols_.size());
+    vector<double> alpha;
+
+    for (int iter = 0; iter < kSimplexMaxIter; iter++) {
+        // 选择出基行: 越界最多的基变量
+        int leave_row = -1;
+        double max_infeas = kSimplexFeasTol;
+        for (int r = 0; r < m; r++) {
+            double x = lp.x_basic_[r];
+            double ub = lp.ubs_[lp.basis_[r]];
+            double infeas = max(-x, x - ub);
+            if (infeas > max_infeas) {
+                max_infeas = infeas;
+                leave_row = r;
+            }
+        }
+
+        if (leave_row < 0) {
+            return 0;
+        }
+
+        // 出基变量低于下界时需要增大 (sign=-1), 高于上界时需要减小 (sign=+1)
+        bool leave_to_upper = lp.x_basic_[leave_row] > 0.0;
+        double sign = leave_to_upper ? 1.0 : -1.0;
+        const double* rho = &lp.basis_inv_[leave_row * m];
+
+        // 比值检验: min |d_j / alpha_rj|, 保持对偶可行
+        ComputeDuals(lp);
+        int enter = -1;
+        double best_ratio = INFINITY;
+        double best_alpha = 0.0;
+        for (int var = 0; var < num_vars; var++) {
+            int status = lp.status_[var];
+            if (status == kVarBasic || lp.ubs_[var] <= 0.0) continue;
+
+            double alpha_r = 0.0;
+            for (auto& [row, coef] : lp.cols_[var]) {
+                alpha_r += rho[row] * coef;
+            }
+
+            bool eligible = (status == kVarAtLower && sign * alpha_r > kSimplexPivotTol) ||
+                            (status == kVarAtUpper && sign * alpha_r < -kSimplexPivotTol);
+            if (!eligible) continue;
+
+            double ratio = fabs(ComputeReducedCost(lp, var)) / fabs(alpha_r);
+            if (ratio < best_ratio - kSimplexPivotTol ||
+                (ratio <= best_ratio + kSimplexPivotTol && fabs(alpha_r) > best_alpha)) {
+                best_ratio = ratio;
+                best_alpha = fabs(alpha_r);
+                enter = var;
+            }
+        }
+
+        if (enter < 0) {
+            return 1;
+        }
+
+        ComputeColumn(lp, enter, alpha);
+        SetNonbasic(lp, lp.basis_[leave_row], leave_to_upper);
+        Pivot(lp, leave_row, enter, alpha);
+        lp.total_iters_++;
+
+        if (lp.num_pivots_ >= kSimplexRefactorInterval && !RefactorBasis(lp)) {
+            return 2;
+        }
+        ComputeBasicValues(lp);
+    }
+
+    return 2;
+}
+
+// 将取值为0的基内人工变量换出 (退化换基)
+// 否则对偶价格会带上大M费用
+// 返回: 换出的人工变量数
+static int DriveOutArtificials(SimplexLP& lp) {
+    int m = lp.num_rows_;
+    int num_vars = static_cast<int>(lp.cols_.size());
+    int num_driven = 0;
+    vector<double> alpha;
+
+    for (int r = 0; r < m; r++) {
+        int basic_var = lp.basis_[r];
+        if (!IsArtificial(lp, basic_var)) continue;
+
+        for (int var = 0; var < num_vars; var++) {
+            if (lp.status_[var] == kVarBasic || IsArtificial(lp, var) ||
+                lp.ubs_[var] <= 0.0) {
+                continue;
+            }
+
+            // (B^-1 * a_j)_r
+            double alpha_r = 0.0;
+            for (auto& [row, coef] : lp.cols_[var]) {
+                alpha_r += lp.basis_inv_[r * m + row] * coef;
+            }
+            if (fabs(alpha_r) < 1.0e-7) continue;
+
+            double enter_value = (lp.status_[var] == kVarAtUpper) ? lp.ubs_[var] : 0.0;
+            ComputeColumn(lp, var, alpha);
+            SetNonbasic(lp, basic_var, false);
+            Pivot(lp, r, var, alpha);
+            lp.x_basic_[r] = enter_value;
+            num_driven++;
+            break;
+        }
+    }
+
+    return num_driven;
+}
+
+// 初始化: 建立约束行与剩余/人工变量, 初始基为人工变量
+void InitSimplexLP(SimplexLP& lp, const vector<double>& rhs) {
+    int m = static_cast<int>(rhs.size());
+
+    lp.num_rows_ = m;
+    lp.rhs_ = rhs;
+    lp.cols_.clear();
+    lp.costs_.clear();
+    lp.ubs_.clear();
+    lp.status_.clear();
+
+    // 剩余变量 (系数-1)
+    for (int r = 0; r < m; r++) {
+        lp.cols_.push_back({{r, -1.0}});
+        lp.costs_.push_back(0.0);
+        lp.ubs_.push_back(INFINITY);
+        lp.status_.push_back(kVarAtLower);
+    }
+    // 人工变量 (系数+1, 费用M)
+    for (int r = 0; r < m; r++) {
+        lp.cols_.push_back({{r, 1.0}});
+        lp.costs_.push_back(kSimplexBigM);
+        lp.ubs_.push_back(INFINITY);
+        lp.status_.push_back(kVarBasic);
+    }
+
+    lp.basis_.resize(m);
+    for (int r = 0; r < m; r++) {
+        lp.basis_[r] = m + r;
+    }
+    lp.basis_inv_.clear();
+    lp.x_basic_.clear();
+    lp.duals_.assign(m, 0.0);
+    lp.obj_val_ = 0.0;
+    lp.num_pivots_ = 0;
+    lp.total_iters_ = 0;
+}
+
+// 加入结构变量 (非基, 取下界0), 当前基保持原始可行
+// 返回: 变量编号
+int AddSimplexColumn(SimplexLP& lp, const SparseColumn& col,
+    double cost, double ub) {
+
+    lp.cols_.push_back(col);
+    lp.costs_.push_back(cost);
+    lp.ubs_.push_back(ub);
+    lp.status_.push_back(kVarAtLower);
+
+    return static_cast<int>(lp.cols_.size()) - 1;
+}
+
+// 删除结构变量 (remove_flags[var]=1), 只允许删除非基变量
+// 返回: 旧编号 -> 新编号 (-1表示已删除)
+vector<int> RemoveSimplexColumns(SimplexLP& lp, const vector<int>& remove_flags) {
+    int num_vars = static_cast<int>(lp.cols_.size());
+    vector<int> new_index(num_vars, -1);
+
+    int next = 0;
+    for (int var = 0; var < num_vars; var++) {
+        bool removable = var >= 2 * lp.num_rows_ && lp.status_[var] != kVarBasic;
+        if (remove_flags[var] == 1 && removable) continue;
+
+        new_index[var] = next;
+        if (next != var) {
+            lp.cols_[next] = move(lp.cols_[var]);
+            lp.costs_[next] = lp.costs_[var];
+            lp.ubs_[next] = lp.ubs_[var];
+            lp.status_[next] = lp.status_[var];
+        }
+        next++;
+    }
+
+    lp.cols_.resize(next);
+    lp.costs_.resize(next);
+    lp.ubs_.resize(next);
+    lp.status_.resize(next);
+
+    for (int& var : lp.basis_) {
+        var = new_index[var];
+    }
+
+    return new_index;
+}
+
+// 载入基状态 (status[var]为SimplexVarStatus, 人工变量一律固定为0)
+// 返回: false=基变量个数与行数不符, 未载入
+bool SetSimplexBasis(SimplexLP& lp, const vector<int>& status) {
+    int m = lp.num_rows_;
+    int num_vars = static_cast<int>(lp.cols_.size());
+
+    vector<int> basis;
+    for (int var = 0; var < num_vars; var++) {
+        if (!IsArtificial(lp, var) && status[var] == kVarBasic) {
+            basis.push_back(var);
+        }
+    }
+    if ((int)basis.size() != m) {
+        return false;
+    }
+
+    for (int var = 0; var < num_vars; var++) {
+        if (IsArtificial(lp, var)) {
+            lp.ubs_[var] = 0.0;
+            lp.status_[var] = kVarAtLower;
+        } else if (status[var] == kVarAtUpper && lp.ubs_[var] == INFINITY) {
+            lp.status_[var] = kVarAtLower;
+        } else {
+            lp.status_[var] = status[var];
+        }
+    }
+    lp.basis_ = basis;
+
+    return true;
+}
+
+// 求解LP (从上次的基热启动)
+// 返回: true=找到最优解, false=不可行/无界/迭代超限
+bool SolveSimplexLP(SimplexLP& lp) {
+    if (!RefactorBasis(lp)) {
+        ResetBasis(lp);
+        RefactorBasis(lp);
+    }
+    ComputeBasicValues(lp);
+
+    // 载入的热启动基在修改变量上界后可能原始不可行: 对偶可行时用对偶单纯形恢复,
+    // 否则退回人工变量初始基
+    if (!IsPrimalFeasible(lp)) {
+        int dual_status = IsDualFeasible(lp) ? RunDualSimplex(lp) : 2;
+        if (dual_status == 1) {
+            LOG("[Simplex] 主问题不可行 (对偶单纯形)");
+            return false;
+        }
+        if (dual_status == 2) {
+            ResetBasis(lp);
+            RefactorBasis(lp);
+            ComputeBasicValues(lp);
+        }
+    }
+
+    int status = 0;
+    while (true) {
+        status = RunPrimalSimplex(lp);
+        if (status != 0) break;
+
+        // 人工变量取正值: 原问题不可行
+        bool infeasible = false;
+        for (int r = 0; r < lp.num_rows_; r++) {
+            if (IsArtificial(lp, lp.basis_[r]) && lp.x_basic_[r] > kSimplexFeasTol) {
+                infeasible = true;
+                break;
+            }
+        }
+        if (infeasible) {
+            LOG("[Simplex] 主问题不可行");
+            return false;
+        }
+
+        if (DriveOutArtificials(lp) == 0) break;
+    }
+
+    if (status == 1) {
+        LOG("[Simplex] 主问题无界");
+        return false;
+    }
+    if (status == 2) {
+        LOG_FMT("[Simplex] 达到迭代上限 %d\n", kSimplexMaxIter);
+        return false;
+    }
+
+    ComputeDuals(lp);
+
+    lp.obj_val_ = 0.0;
+    for (int r = 0; r < lp.num_rows_; r++) {
+        lp.obj_val_ += lp.costs_[lp.basis_[r]] * lp.x_basic_[r];
+    }
+    int num_vars = static_cast<int>(lp.cols_.size());
+    for (int var = 0; var < num_vars; var++) {
+        if (lp.status_[var] == kVarAtUpper) {
+            lp.obj_val_ += lp.costs_[var] * lp.ubs_[var];
+        }
+    }
+
+    return true;
+}
+
+// 读取全部变量取值
+void GetSimplexValues(SimplexLP& lp, vector<double>& values) {
+    int num_vars = static_cast<int>(lp.cols_.size());
+
+    values.assign(num_vars, 0.0);
+    for (int var = 0; var < num_vars; var++) {
+        if (lp.status_[var] == kVarAtUpper) {
+            values[var] = lp.ubs_[var];
+        }
+    }
+    for (int r = 0; r < lp.num_rows_; r++) {
+        values[lp.basis_[r]] = max(0.0, lp.x_basic_[r]);
+    }
+}
+
+// 读取变量检验数 (需在SolveSimplexLP之后调用)
+double GetSimplexReducedCost(SimplexLP& lp, int var) {
+    if (lp.status_[var] == kVarBasic) {
+        return 0.0;
+    }
+    return ComputeReducedCost(lp, var);
+}
@@ -0,0 +1,255 @@
+// =============================================================================
+// sp_models.cpp - CPLEX子问题模型 (启用常驻时只建一次, 每次定价只更新目标系数)
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+#ifndef CS_NO_CPLEX
+// 创建空模型 (目标系数全为0, 由SetSPObjective填入)
+static unique_ptr<CplexSPModel> NewSPModel() {
+    auto sp = make_unique<CplexSPModel>();
+    sp->model_ = IloModel(sp->env_);
+    sp->vars_ = IloNumVarArray(sp->env_);
+    sp->obj_ = IloMaximize(sp->env_);
+    sp->model_.add(sp->obj_);
+    return sp;
+}
+
+// 模型建立完毕: 分配目标系数缓冲并提取到求解器
+static void FinishSPModel(CplexSPModel& sp) {
+    sp.obj_coefs_ = IloNumArray(sp.env_, sp.vars_.getSize());
+    sp.cplex_ = IloCplex(sp.env_);
+    sp.cplex_.extract(sp.model_);
+    sp.cplex_.setOut(sp.env_.getNullStream());
+}
+
+// 槽位中的模型可否复用: 启用常驻模型时复用; 否则释放旧模型, 由调用方重新建立
+// (每次求解都是新建的模型, 与逐次建模相同)
+static bool ReuseSPModel(ProblemParams& params, unique_ptr<CplexSPModel>& slot) {
+    if (!slot) {
+        return false;
+    }
+    if (params.resident_sp_models_) {
+        return true;
+    }
+    slot->env_.end();
+    slot.reset();
+    return false;
+}
+
+// Arc Flow变量: arc_items_的每一项 (Arc, 物品) 一个0-1变量, 类型即物品下标 (损耗弧为-1)
+static void AddArcFlowVars(CplexSPModel& sp, const ArcFlowGraph& graph) {
+    int num_vars = static_cast<int>(graph.arc_items_.size());
+    for (int v = 0; v < num_vars; v++) {
+        string var_name = "a_" + to_string(v + 1);
+        sp.vars_.add(IloNumVar(sp.env_, 0, 1, ILOINT, var_name.c_str()));
+        sp.var_types_.push_back(graph.arc_items_[v]);
+    }
+}
+
+// Arc Flow约束: 容量约束 + 起点/终点约束 + 中间节点流量守恒
+// 一条Arc的流量为其全部 (Arc, 物品) 变量之和
+static void AddArcFlowConstraints(CplexSPModel& sp, const ArcFlowGraph& graph) {
+    IloEnv env = sp.env_;
+    IloNumVarArray& vars = sp.vars_;
+    int num_nodes = static_cast<int>(graph.node_pos_.size());
+    int num_arcs = static_cast<int>(graph.arc_tail_.size());
+    int end_node = num_nodes - 1;
+
+    auto add_arc_flow = [&](IloExpr& expr, int a) {
+        for (int v = graph.arc_item_offsets_[a]; v < graph.arc_item_offsets_[a + 1]; v++) {
+            expr += vars[v];
+        }
+    };
+
+    IloExpr cap_expr(env);
+    for (int a = 0; a < num_arcs; a++) {
+        int arc_len = graph.node_pos_[graph.arc_head_[a]] - graph.node_pos_[graph.arc_tail_[a]];
+        for (int v = graph.arc_item_offsets_[a]; v < graph.arc_item_offsets_[a + 1]; v++) {
+            cap_expr += arc_len * vars[v];
+        }
+    }
+    sp.model_.add(cap_expr <= graph.capacity_);
+    cap_expr.end();
+
+    IloExpr begin_expr(env);
+    for (int a = graph.out_offsets_[0]; a < graph.out_offsets_[1]; a++) {
+        add_arc_flow(begin_expr, a);
+    }
+    sp.model_.add(begin_expr == 1);
+    begin_expr.end();
+
+    IloExpr end_expr(env);
+    for (int k = graph.in_offsets_[end_node]; k < graph.in_offsets_[end_node + 1]; k++) {
+        add_arc_flow(end_expr, graph.in_arcs_[k]);
+    }
+    sp.model_.add(end_expr == 1);
+    end_expr.end();
+
+    for (int node = 1; node < end_node; node++) {
+        IloExpr in_expr(env);
+        IloExpr out_expr(env);
+        for (int k = graph.in_offsets_[node]; k < graph.in_offsets_[node + 1]; k++) {
+            add_arc_flow(in_expr, graph.in_arcs_[k]);
+        }
+        for (int a = graph.out_offsets_[node]; a < graph.out_offsets_[node + 1]; a++) {
+            add_arc_flow(out_expr, a);
+        }
+        sp.model_.add(in_expr == out_expr);
+        in_expr.end();
+        out_expr.end();
+    }
+}
+
+// SP1背包模型: max sum(v_j * G_j), s.t. sum(w_j * G_j) <= W
+CplexSPModel& GetSP1KnapsackModel(ProblemParams& params, ProblemData& data) {
+    if (ReuseSPModel(params, data.sp1_knapsack_model_)) {
+        return *data.sp1_knapsack_model_;
+    }
+
+    auto sp = NewSPModel();
+    int num_strip_types = params.num_strip_types_;
+
+    IloExpr wid_expr(sp->env_);
+    for (int j = 0; j < num_strip_types; j++) {
+        string var_name = "G_" + to_string(j + 1);
+        int bound = StripCountBound(params, data, j);
+        IloNumVar var(sp->env_, 0, (bound == INT_MAX) ? IloInfinity : bound, ILOINT,
+            var_name.c_str());
+        sp->vars_.add(var);
+        sp->var_types_.push_back(j);
+        wid_expr += data.strip_types_[j].width_ * var;
+    }
+    sp->model_.add(wid_expr <= params.stock_width_);
+    wid_expr.end();
+
+    FinishSPModel(*sp);
+    data.sp1_knapsack_model_ = move(sp);
+    return *data.sp1_knapsack_model_;
+}
+
+// SP1 Arc Flow模型: 每条Arc上每种可放置的条带类型一个0-1变量
+CplexSPModel& GetSP1ArcFlowModel(ProblemParams& params, ProblemData& data) {
+    if (ReuseSPModel(params, data.sp1_arc_model_)) {
+        return *data.sp1_arc_model_;
+    }
+
+    auto sp = NewSPModel();
+    AddArcFlowVars(*sp, data.sp1_arc_data_);
+    AddArcFlowConstraints(*sp, data.sp1_arc_data_);
+    AddSP1ArcCountBounds(params, data, sp->model_, sp->vars_);
+
+    FinishSPModel(*sp);
+    data.sp1_arc_model_ = move(sp);
+    return *data.sp1_arc_model_;
+}
+
+// SP2模型槽位按条带类型数分配
+// 并行定价前须在主线程调用, 之后各线程只访问自己条带类型的槽位
+void PrepareSP2Models(ProblemParams& params, ProblemData& data) {
+    size_t num_strip_types = static_cast<size_t>(params.num_strip_types_);
+    if (data.sp2_knapsack_models_.size() < num_strip_types) {
+        data.sp2_knapsack_models_.resize(num_strip_types);
+    }
+    if (data.sp2_arc_models_.size() < num_strip_types) {
+        data.sp2_arc_models_.resize(num_strip_types);
+    }
+}
+
+// SP2背包模型: max sum(pi_i * D_i), s.t. sum(l_i * D_i) <= L
+// 宽度超过条带的子件上界为0
+CplexSPModel& GetSP2KnapsackModel(ProblemParams& params, ProblemData& data,
+    int strip_type_id) {
+
+    PrepareSP2Models(params, data);
+    unique_ptr<CplexSPModel>& slot = data.sp2_knapsack_models_[strip_type_id];
+    if (ReuseSPModel(params, slot)) {
+        return *slot;
+    }
+
+    auto sp = NewSPModel();
+    int num_item_types = params.num_item_types_;
+    int strip_width = data.strip_types_[strip_type_id].width_;
+
+    IloExpr len_expr(sp->env_);
+    for (int i = 0; i < num_item_types; i++) {
+        string var_name = "D_" + to_string(i + 1);
+        bool fits = data.item_types_[i].width_ <= strip_width;
+        int bound = fits ? ItemCountBound(params, data, i) : 0;
+        IloNumVar var(sp->env_, 0, (bound == INT_MAX) ? IloInfinity : bound, ILOINT,
+            var_name.c_str());
+        sp->vars_.add(var);
+        sp->var_types_.push_back(i);
+        if (fits) {
+            len_expr += data.item_types_[i].length_ * var;
+        }
+    }
+    sp->model_.add(len_expr <= params.stock_length_);
+    len_expr.end();
+
+    FinishSPModel(*sp);
+    slot = move(sp);
+    return *slot;
+}
+
+// SP2 Arc Flow模型: 每条Arc上每种可放置的子件类型一个0-1变量
+// (长度相同而宽度或需求不同的子件各自计价和计数)
+CplexSPModel& GetSP2ArcFlowModel(ProblemParams& params, ProblemData& data,
+    int strip_type_id) {
+
+    PrepareSP2Models(params, data);
+    unique_ptr<CplexSPModel>& slot = data.sp2_arc_models_[strip_type_id];
+    if (ReuseSPModel(params, slot)) {
+        return *slot;
+    }
+
+    auto sp = NewSPModel();
+    const ArcFlowGraph& graph = data.sp2_arc_data_[strip_type_id];
+    AddArcFlowVars(*sp, graph);
+    AddArcFlowConstraints(*sp, graph);
+    AddSP2ArcCountBounds(params, data, strip_type_id, sp->model_, sp->vars_);
+
+    FinishSPModel(*sp);
+    slot = move(sp);
+    return *slot;
+}
+
+// 按类型价值更新目标系数: 变量系数 = type_values[var_types_[v]]
+void SetSPObjective(CplexSPModel& sp, const vector<double>& type_values) {
+    int num_vars = static_cast<int>(sp.var_types_.size());
+    for (int v = 0; v < num_vars; v++) {
+        int type = sp.var_types_[v];
+        sp.obj_coefs_[v] = (type >= 0) ? type_values[type] : 0.0;
+    }
+    sp.obj_.setLinearCoefs(sp.vars_, sp.obj_coefs_);
+    sp.solve_count_++;
+}
+
+// 释放全部常驻子问题模型并输出统计
+void EndSPModels(ProblemData& data) {
+    int num_models = 0;
+    int num_solves = 0;
+    auto release = [&](unique_ptr<CplexSPModel>& sp) {
+        if (!sp) return;
+        num_models++;
+        num_solves += sp->solve_count_;
+        sp->env_.end();
+        sp.reset();
+    };
+
+    release(data.sp1_knapsack_model_);
+    release(data.sp1_arc_model_);
+    for (auto& sp : data.sp2_knapsack_models_) {
+        release(sp);
+    }
+    for (auto& sp : data.sp2_arc_models_) {
+        release(sp);
+    }
+
+    if (num_models > 0) {
+        LOG_FMT("[SP] 常驻子问题模型 %d 个, 累计求解 %d 次\n", num_models, num_solves);
+    }
+}
+#endif  // CS_NO_CPLEX
@@ -0,0 +1,121 @@
+// =============================================================================
+// stabilization.cpp - 列生成对偶稳定化
+// 位于主问题对偶价格提取与SP1/SP2定价之间:
+//   - Wentges平滑: pi_sep = alpha * pi_center + (1 - alpha) * pi_mp
+//   - Box-step: pi_sep = clamp(pi_mp, pi_center - delta, pi_center + delta)
+// 稳定中心取上一轮的定价对偶价格; 出现误定价时用主问题对偶价格重新定价
+// =============================================================================
+
+#include "2DBP.h"
+
+using namespace std;
+
+// 初始化节点的稳定化状态 (每次列生成开始时调用)
+// 非根节点以父节点最终对偶价格作为初始稳定中心
+void InitDualStabilization(ProblemParams& params, BPNode& node) {
+    node.mp_duals_.clear();
+    node.stab_center_ = node.parent_duals_;
+    node.stab_alpha_ = params.stab_alpha_;
+    node.stab_delta_ = params.stab_delta_;
+    node.mispricing_count_ = 0;
+}
+
+// 计算稳定化后的定价对偶价格
+// 主问题对偶价格保存到node.mp_duals_, node.duals_改写为定价用的对偶价格
+// 返回: true=定价对偶价格与主问题对偶价格不同
+bool StabilizeDuals(ProblemParams& params, BPNode& node) {
+    node.mp_duals_ = node.duals_;
+
+    if (params.stab_mode_ == kNoStabilization) {
+        return false;
+    }
+
+    // 第一轮没有稳定中心, 直接使用主问题对偶价格
+    if (node.stab_center_.size() != node.duals_.size()) {
+        node.stab_center_ = node.duals_;
+        return false;
+    }
+
+    int num_rows = static_cast<int>(node.duals_.size());
+    bool changed = false;
+
+    for (int row = 0; row < num_rows; row++) {
+        double pi_mp = node.mp_duals_[row];
+        double pi_center = node.stab_center_[row];
+        double pi_sep = pi_mp;
+
+        if (params.stab_mode_ == kSmoothing) {
+            pi_sep = node.stab_alpha_ * pi_center + (1 - node.stab_alpha_) * pi_mp;
+        } else if (params.stab_mode_ == kBoxStep) {
+            pi_sep = min(max(pi_mp, pi_center - node.stab_delta_), pi_center + node.stab_delta_);
+        }
+
+        if (fabs(pi_sep - pi_mp) > kZeroTolerance) {
+            changed = true;
+        }
+        node.duals_[row] = pi_sep;
+    }
+
+    // 本轮定价点作为下一轮的稳定中心
+    node.stab_center_ = node.duals_;
+    return changed;
+}
+
+// 统计待加入列中在给定对偶价格下检验数为负的列数
+int CountImprovingColumns(ProblemParams& params, BPNode& node,
+    const vector<double>& duals) {
+
+    int num_strip_types = params.num_strip_types_;
+    int count = 0;
+
+    // Y列检验数: 1 - sum(C_j * pi_j)
+    for (YColumn& y_col : node.new_y_cols_) {
+        double val = 0;
+        for (int j = 0; j < num_strip_types; j++) {
+            val += y_col.pattern_[j] * duals[j];
+        }
+        if (val > 1 + kRcTolerance) count++;
+    }
+
+    // X列检验数: pi_j - sum(B_i * mu_i)
+    for (XColumn& x_col : node.new_x_cols_) {
+        double val = 0;
+        for (int i = 0; i < params.num_item_types_; i++) {
+            val += x_col.pattern_[i] * duals[num_strip_types + i];
+        }
+        if (val > duals[x_col.strip_type_id_] + kRcTolerance) count++;
+    }
+
+    return count;
+}
+
+// 恢复主问题对偶价格并检测误定价
+// 误定价: 稳定化对偶价格下得到的列在主问题对偶价格下均无改进
+// 此时丢弃这些列, 放松稳定化强度 (alpha减半 / delta加倍)
+// 返回: true=发生误定价, 需用主问题对偶价格重新定价
+bool DetectMispricing(ProblemParams& params, BPNode& node) {
+    node.duals_ = node.mp_duals_;
+
+    int num_improving = CountImprovingColumns(params, node, node.duals_);
+    if (num_improving > 0) {
+        return false;
+    }
+
+    node.new_y_cols_.clear();
+    node.new_x_cols_.clear();
+    node.mispricing_count_++;
+
+    if (params.stab_mode_ == kSmoothing) {
+        node.stab_alpha_ *= 0.5;
+        if (node.stab_alpha_ < 0.05) node.stab_alpha_ = 0;
+    } else if (params.stab_mode_ == kBoxStep) {
+        node.stab_delta_ *= 2;
+    }
+
+    // 稳定中心移到主问题对偶价格
+    node.stab_center_ = node.duals_;
+
+    LOG_FMT("[Stab] 误定价 (第%d次), alpha=%.3f, delta=%.3f\n",
+        node.mispricing_count_, node.stab_alpha_, node.stab_delta_);
+    return true;
+}